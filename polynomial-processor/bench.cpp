@@ -0,0 +1,422 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "include/Division.h"
+#include "include/FileProcessor.h"
+#include "include/LineReader.h"
+#include "include/Power.h"
+#include "include/Workload.h"
+
+struct BenchmarkSettings
+{
+    CoefficientType type = CoefficientType::Float;
+    // Minimum time each measurement runs for; the number of iterations doubles until it is reached
+    double minSeconds = 0.2;
+    bool quick = false;
+};
+
+// Results are added here, so the compiler cannot drop the measured operations
+static volatile int64_t sink = 0;
+
+/**
+ * @brief Resets the peak resident set size of the process, where the kernel allows it.
+ */
+static void resetPeakMemory()
+{
+    int descriptor = ::open("/proc/self/clear_refs", O_WRONLY);
+    if (descriptor < 0)
+        return;
+    ssize_t written = ::write(descriptor, "5", 1);
+    (void)written;
+    ::close(descriptor);
+}
+
+/**
+ * @brief Returns the peak resident set size of the process in KiB, since the last `resetPeakMemory`.
+ */
+static long peakMemory()
+{
+    LineReader status("/proc/self/status");
+    std::string_view line;
+    while (status.isOpen() && status.next(line))
+    {
+        if (line.substr(0, 6) == "VmHWM:")
+            return std::strtol(std::string(line.substr(6)).c_str(), nullptr, 10);
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+struct Measurement
+{
+    int64_t iterations;
+    double nanoseconds; // Per iteration
+};
+
+/**
+ * @brief Runs an operation until it has taken at least `minSeconds`, doubling the iterations each round.
+ *
+ * @return The iterations of the last round and the mean time of one of them.
+ */
+template <typename F>
+static Measurement measure(F &&operation, double minSeconds)
+{
+    int64_t iterations = 1;
+    while (true)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int64_t i = 0; i < iterations; i++)
+            operation();
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (elapsed >= minSeconds || iterations >= (int64_t(1) << 40))
+            return {iterations, elapsed * 1e9 / (double)iterations};
+        iterations *= 2;
+    }
+}
+
+/**
+ * @class Report
+ * @brief Collects the measurements as the entries of a JSON array.
+ *
+ * Every entry has the same keys in the same order, and numbers are written with `to_chars`, so the
+ * output of two runs can be compared line by line.
+ */
+class Report
+{
+private:
+    OutputBuffer entries;
+    bool first = true;
+
+    void begin(const std::string &name, int degree, double density)
+    {
+        entries << (first ? "\n" : ",\n") << "    {\"name\": \"" << name << "\", \"degree\": " << degree << ", \"density\": ";
+        entries.writeValue(density);
+        first = false;
+    }
+
+    void end(const Measurement &measurement, const char *rateKey, double items)
+    {
+        entries << ", \"iterations\": " << measurement.iterations << ", \"ns_per_op\": ";
+        entries.writeValue(measurement.nanoseconds);
+        entries << ", \"" << rateKey << "\": ";
+        entries.writeValue(items * 1e9 / measurement.nanoseconds);
+        entries << ", \"peak_rss_kb\": " << peakMemory() << "}";
+    }
+
+public:
+    // A List operation on polynomials of `terms` terms; throughput in terms per second
+    void addOperation(const std::string &name, int degree, double density, int terms, const Measurement &measurement)
+    {
+        begin("list/" + name, degree, density);
+        entries << ", \"terms\": " << terms;
+        end(measurement, "terms_per_second", terms);
+    }
+
+    // A processFile run over a file of `blocks` blocks; throughput in bytes per second
+    void addFile(int degree, double density, int blocks, size_t bytes, const Measurement &measurement)
+    {
+        begin("processFile", degree, density);
+        entries << ", \"blocks\": " << blocks << ", \"bytes\": " << bytes;
+        end(measurement, "bytes_per_second", (double)bytes);
+    }
+
+    std::string_view view() const { return entries.view(); }
+};
+
+/**
+ * @brief Measures every List operation on random polynomials of a given shape.
+ */
+template <typename T>
+static void benchmarkOperations(Report &report, const BenchmarkSettings &settings, int degree, double density)
+{
+    WorkloadSpec spec;
+    spec.degree = degree;
+    spec.density = density;
+
+    std::mt19937_64 random(spec.seed);
+    BasicList<T> a = generatePolynomial<T>(spec, random);
+    BasicList<T> b = generatePolynomial<T>(spec, random);
+    T x = generatePoints<T>(1, random)[0];
+    int terms = a.size();
+
+    // Insertion in random order is quadratic on the linked list, so it stops at degree 10⁴
+    if (degree <= 10000)
+    {
+        std::vector<std::pair<int, T>> shuffled;
+        for (const BasicNode<T> *current = a.getHead(); current != nullptr; current = current->getNext())
+            shuffled.emplace_back(current->getDegree(), current->getCoefficient());
+        std::shuffle(shuffled.begin(), shuffled.end(), random);
+
+        resetPeakMemory();
+        Measurement insert = measure([&]()
+                                     {
+                                         BasicList<T> built;
+                                         for (const std::pair<int, T> &term : shuffled)
+                                             built.insert(term.second, term.first);
+                                         sink = sink + built.size(); },
+                                     settings.minSeconds);
+        report.addOperation("insert", degree, density, terms, insert);
+    }
+
+    resetPeakMemory();
+    report.addOperation("add", degree, density, terms, measure([&]()
+                                                               { sink = sink + (a + b).size(); },
+                                                               settings.minSeconds));
+    resetPeakMemory();
+    report.addOperation("subtract", degree, density, terms, measure([&]()
+                                                                    { sink = sink + (a - b).size(); },
+                                                                    settings.minSeconds));
+    resetPeakMemory();
+    report.addOperation("multiply", degree, density, terms, measure([&]()
+                                                                    { sink = sink + (a * b).size(); },
+                                                                    settings.minSeconds));
+    resetPeakMemory();
+    report.addOperation("square", degree, density, terms, measure([&]()
+                                                                  { BasicList<T> square;
+                                                                    polynomialPower(a, 2, square);
+                                                                    sink = sink + square.size(); },
+                                                                  settings.minSeconds));
+    // Divides the product by one of its factors, so the division is exact for int64_t too
+    BasicList<T> product = a * b;
+    resetPeakMemory();
+    report.addOperation("divide", degree, density, terms, measure([&]()
+                                                                  { BasicList<T> quotient, remainder;
+                                                                    dividePolynomials(product, b, quotient, remainder);
+                                                                    sink = sink + quotient.size(); },
+                                                                  settings.minSeconds));
+    resetPeakMemory();
+    report.addOperation("evaluate", degree, density, terms, measure([&]()
+                                                                    { sink = sink + (a.evaluateAt(x) != T(0)); },
+                                                                    settings.minSeconds));
+    resetPeakMemory();
+    report.addOperation("copy", degree, density, terms, measure([&]()
+                                                                { BasicList<T> copy(a);
+                                                                  sink = sink + copy.size(); },
+                                                                settings.minSeconds));
+
+    OutputBuffer text;
+    resetPeakMemory();
+    report.addOperation("format", degree, density, terms, measure([&]()
+                                                                  { text.clear();
+                                                                    a.format(text);
+                                                                    sink = sink + (int64_t)text.size(); },
+                                                                  settings.minSeconds));
+}
+
+/**
+ * @brief Measures `processFile` over a generated command file, with the results sent to /dev/null.
+ */
+template <typename T>
+static void benchmarkFile(Report &report, const BenchmarkSettings &settings, int degree, double density, int blocks)
+{
+    WorkloadSpec spec;
+    spec.degree = degree;
+    spec.density = density;
+
+    char path[] = "/tmp/polynomial-bench-XXXXXX";
+    int descriptor = mkstemp(path);
+    if (descriptor < 0)
+    {
+        std::cerr << "Erro: Não foi possível criar o arquivo temporário da carga de trabalho." << std::endl;
+        exit(1);
+    }
+    {
+        OutputBuffer file(descriptor);
+        writeWorkload<T>(file, spec, blocks);
+    }
+    size_t bytes = (size_t)lseek(descriptor, 0, SEEK_END);
+    ::close(descriptor);
+
+    standardOutput().flush();
+    int savedOutput = dup(STDOUT_FILENO);
+    int devNull = ::open("/dev/null", O_WRONLY);
+    dup2(devNull, STDOUT_FILENO);
+
+    resetPeakMemory();
+    Measurement measurement = measure([&]()
+                                      { processFile<T>(path, 1); },
+                                      settings.minSeconds);
+
+    dup2(savedOutput, STDOUT_FILENO);
+    ::close(savedOutput);
+    ::close(devNull);
+    unlink(path);
+
+    report.addFile(degree, density, blocks, bytes, measurement);
+}
+
+/**
+ * @brief Runs every benchmark with coefficients of type T and prints the JSON report.
+ */
+template <typename T>
+static void runBenchmarks(const BenchmarkSettings &settings, const char *storage)
+{
+    std::vector<int> degrees = {1000, 10000, 100000};
+    std::vector<int> fileDegrees = {100, 1000, 10000};
+    if (settings.quick)
+    {
+        degrees.pop_back();
+        fileDegrees.pop_back();
+    }
+
+    Report report;
+    for (double density : {1.0, 0.01})
+    {
+        for (int degree : degrees)
+            benchmarkOperations<T>(report, settings, degree, density);
+    }
+    for (double density : {1.0, 0.01})
+    {
+        for (int degree : fileDegrees)
+            benchmarkFile<T>(report, settings, degree, density, 20);
+    }
+
+    OutputBuffer json;
+    json << "{\n  \"schema\": 1,\n  \"type\": \"" << CoefficientTraits<T>::NAME << "\",\n  \"storage\": \"" << storage
+         << "\",\n  \"min_seconds\": ";
+    json.writeValue(settings.minSeconds);
+    json << ",\n  \"benchmarks\": [" << report.view() << "\n  ]\n}\n";
+    std::cout << json.view() << std::flush;
+}
+
+/**
+ * @brief Writes a synthetic command file with polynomials of type T.
+ */
+template <typename T>
+static void generate(const std::string &path, const WorkloadSpec &spec, int blocks)
+{
+    int descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0)
+    {
+        std::cerr << "Erro: Não foi possível abrir o arquivo '" << path << "' para escrita." << std::endl;
+        exit(1);
+    }
+    {
+        OutputBuffer out(descriptor);
+        writeWorkload<T>(out, spec, blocks);
+    }
+    ::close(descriptor);
+}
+
+/**
+ * @brief Parses a number option, exiting with the usage message if it is not a number.
+ */
+static double parseNumber(const std::string &option, const std::string &text)
+{
+    char *end = nullptr;
+    double value = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || value < 0)
+    {
+        std::cerr << "Erro: Valor inválido para " << option << ": '" << text << "'." << std::endl;
+        exit(1);
+    }
+    return value;
+}
+
+int main(int argc, char *argv[])
+{
+    BenchmarkSettings settings;
+    WorkloadSpec spec;
+    std::string storage = "auto";
+    std::string generatePath;
+    int blocks = 100;
+
+    for (int argument = 1; argument < argc; argument++)
+    {
+        std::string option = argv[argument];
+        if (option == "--quick")
+        {
+            settings.quick = true;
+            settings.minSeconds = 0.05;
+            continue;
+        }
+        if (argument + 1 >= argc)
+        {
+            std::cerr << "Uso: " << argv[0] << " [--type float|double|int64|mod] [--storage auto|linked|dense] [--min-time s] [--quick]\n"
+                      << "     " << argv[0] << " --generate arquivo [--type T] [--degree n] [--density p]"
+                      << " [--distribution uniform|integers|normal] [--blocks n] [--seed n]" << std::endl;
+            return 1;
+        }
+
+        std::string value = argv[++argument];
+        if (option == "--type")
+        {
+            if (!parseCoefficientType(value, settings.type))
+            {
+                std::cerr << "Erro: Tipo de coeficiente inválido '" << value << "' (use float, double, int64 ou mod)." << std::endl;
+                return 1;
+            }
+        }
+        else if (option == "--storage")
+        {
+            // "linked" never leaves the linked list, "dense" never leaves the coefficient array
+            storage = value;
+            if (value == "linked")
+                storageSettings().minDenseTerms = INT_MAX;
+            else if (value == "dense")
+            {
+                storageSettings().minDenseTerms = 0;
+                storageSettings().denseRatio = 0.0f;
+                storageSettings().sparseRatio = 0.0f;
+            }
+            else if (value != "auto")
+            {
+                std::cerr << "Erro: Armazenamento inválido '" << value << "' (use auto, linked ou dense)." << std::endl;
+                return 1;
+            }
+        }
+        else if (option == "--min-time")
+            settings.minSeconds = parseNumber(option, value);
+        else if (option == "--generate")
+            generatePath = value;
+        else if (option == "--degree")
+            spec.degree = (int)parseNumber(option, value);
+        else if (option == "--density")
+            spec.density = parseNumber(option, value);
+        else if (option == "--blocks")
+            blocks = (int)parseNumber(option, value);
+        else if (option == "--seed")
+            spec.seed = (uint64_t)parseNumber(option, value);
+        else if (option == "--distribution")
+        {
+            if (!parseCoefficientDistribution(value, spec.distribution))
+            {
+                std::cerr << "Erro: Distribuição inválida '" << value << "' (use uniform, integers ou normal)." << std::endl;
+                return 1;
+            }
+        }
+        else
+        {
+            std::cerr << "Erro: Opção desconhecida '" << option << "'." << std::endl;
+            return 1;
+        }
+    }
+
+    switch (settings.type)
+    {
+        case CoefficientType::Float:
+            generatePath.empty() ? runBenchmarks<float>(settings, storage.c_str()) : generate<float>(generatePath, spec, blocks);
+            break;
+        case CoefficientType::Double:
+            generatePath.empty() ? runBenchmarks<double>(settings, storage.c_str()) : generate<double>(generatePath, spec, blocks);
+            break;
+        case CoefficientType::Int64:
+            generatePath.empty() ? runBenchmarks<int64_t>(settings, storage.c_str()) : generate<int64_t>(generatePath, spec, blocks);
+            break;
+        case CoefficientType::Mod:
+            generatePath.empty() ? runBenchmarks<ModInt>(settings, storage.c_str()) : generate<ModInt>(generatePath, spec, blocks);
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+#ifndef BINARYFORMAT_H
+#define BINARYFORMAT_H
+
+#include "List.h"
+#include "OutputBuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Binary form of a command file, and of the results with `--format binary`. Values are in the byte
+// order of the machine that wrote them, and every section is padded to BINARY_ALIGNMENT bytes, so
+// a mapped file can be read in place:
+//
+//   BinaryHeader
+//   one record per command: BinaryCommand, then `operandCount` operands, each a BinaryOperand followed by
+//     Polynomial: `count` coefficients, then their `count` degrees as int32_t (descending, as written here)
+//     Points:     `count` values
+//     Value:      one value (`count` is 1)
+//     Integer:    one int64_t (`count` is 1)
+//     Text:       `count` characters, such as the text of an expression
+//
+// Coefficients and values are stored as BinaryCoefficient<T>::Stored.
+
+constexpr char BINARY_MAGIC[4] = {'P', 'L', 'Y', 'B'};
+constexpr uint16_t BINARY_VERSION = 1;
+constexpr uint32_t BINARY_BYTE_ORDER = 0x01020304u;
+constexpr std::size_t BINARY_ALIGNMENT = 8;
+
+struct BinaryHeader
+{
+    char magic[4];           // BINARY_MAGIC
+    uint16_t version;        // BINARY_VERSION
+    uint8_t type;            // CoefficientType of every coefficient and value
+    uint8_t coefficientSize; // Size of a stored coefficient
+    uint32_t byteOrder;      // BINARY_BYTE_ORDER as the writer stored it
+    uint32_t reserved;
+};
+
+enum class BinaryOperandKind : uint8_t
+{
+    Polynomial,
+    Points,
+    Value,
+    Integer,
+    Text
+};
+
+struct BinaryCommand
+{
+    char command;         // Command character, as in the text form
+    uint8_t operandCount; // Number of operands that follow
+    uint16_t reserved;
+    uint32_t line;        // Line of the command in the text form (0 in results)
+};
+
+struct BinaryOperand
+{
+    BinaryOperandKind kind;
+    uint8_t reserved[3];
+    uint32_t count;
+};
+
+// Stored form of a coefficient: the value itself, or the canonical residue for ModInt
+// (its Montgomery form depends on the build)
+template <typename T>
+struct BinaryCoefficient
+{
+    using Stored = T;
+    static Stored store(T value) { return value; }
+    static T load(Stored value) { return value; }
+};
+
+template <>
+struct BinaryCoefficient<ModInt>
+{
+    using Stored = uint32_t;
+    static Stored store(ModInt value) { return value.value(); }
+    static ModInt load(Stored value) { return ModInt((int64_t)value); }
+};
+
+class BinaryReader
+{
+private:
+    const char *data;
+    std::size_t length;
+    std::size_t offset;
+
+public:
+    explicit BinaryReader(const std::string &path);
+    ~BinaryReader();
+    BinaryReader(const BinaryReader &other) = delete;
+    BinaryReader &operator=(const BinaryReader &other) = delete;
+
+    bool isOpen() const;
+    const BinaryHeader *header() const;
+    bool atEnd() const;
+    bool hasBufferedInput() const;
+
+    // Next `count` items of the file, in place, or nullptr if the file ends first; the section is padded
+    template <typename U>
+    const U *take(std::size_t count)
+    {
+        std::size_t bytes = count * sizeof(U);
+        if (count > (length - offset) / sizeof(U))
+            return nullptr;
+        const U *items = reinterpret_cast<const U *>(data + offset);
+        offset += (bytes + BINARY_ALIGNMENT - 1) / BINARY_ALIGNMENT * BINARY_ALIGNMENT;
+        if (offset > length)
+            offset = length;
+        return items;
+    }
+};
+
+// Checks whether a file starts with BINARY_MAGIC
+bool isBinaryFile(const std::string &path);
+
+// Writers of the sections of the binary form, each padded to BINARY_ALIGNMENT bytes
+void writeBinaryHeader(OutputBuffer &out, CoefficientType type, std::size_t coefficientSize);
+void writeBinaryCommand(OutputBuffer &out, char command, int operandCount, std::size_t line);
+void writeBinaryInteger(OutputBuffer &out, int64_t value);
+void writeBinaryText(OutputBuffer &out, std::string_view text);
+
+template <typename T>
+void writeBinaryHeader(OutputBuffer &out)
+{
+    writeBinaryHeader(out, CoefficientTraits<T>::TYPE, sizeof(typename BinaryCoefficient<T>::Stored));
+}
+
+template <typename T>
+void writeBinaryPolynomial(OutputBuffer &out, const BasicList<T> &poly);
+
+// Writes `count` values as a Points operand, or a single one as a Value operand
+template <typename T>
+void writeBinaryValues(OutputBuffer &out, BinaryOperandKind kind, const T *values, std::size_t count);
+
+#endif // BINARYFORMAT_H
@@ -0,0 +1,113 @@
+#ifndef COEFFICIENT_H
+#define COEFFICIENT_H
+
+#include "ModInt.h"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+// Coefficient types the polynomial classes are instantiated for
+enum class CoefficientType
+{
+    Float,  // float, the default
+    Double, // double
+    Int64,  // int64_t, exact as long as no result overflows
+    Mod     // ModInt, exact arithmetic modulo ModInt::MODULUS
+};
+
+// Per-type behaviour of a coefficient; specialized for every type in CoefficientType.
+// A value has three text forms: `formatTo` for polynomials (at most two decimals), `printTo` as
+// `std::ostream` would print it, and `exactTo`, the shortest text that parses back to the same value.
+template <typename T>
+struct CoefficientTraits;
+
+// Longest text any of the writers of CoefficientTraits can produce
+constexpr int MAX_NUMBER_LENGTH = 400;
+
+// Parses a number at the start of [first, last) with std::from_chars, also accepting a leading '+';
+// returns the end of the number, or nullptr if there is none
+template <typename T>
+const char *scanNumber(const char *first, const char *last, T &value)
+{
+    if (first != last && *first == '+' && last - first > 1 && first[1] != '-')
+        first++;
+    std::from_chars_result result = std::from_chars(first, last, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+template <>
+struct CoefficientTraits<float>
+{
+    // Type the coefficient-array kernels compute in
+    using Accumulator = double;
+    static constexpr const char *NAME = "float";
+    static constexpr CoefficientType TYPE = CoefficientType::Float;
+
+    static float parse(const std::string &text) { return std::stof(text); }
+    static const char *scan(const char *first, const char *last, float &value) { return scanNumber(first, last, value); }
+    // Writers of the three text forms of a value into [first, last); each returns the end of the text
+    static char *formatTo(char *first, char *last, float value);
+    static char *printTo(char *first, char *last, float value) { return std::to_chars(first, last, value, std::chars_format::general, 6).ptr; }
+    static char *exactTo(char *first, char *last, float value) { return std::to_chars(first, last, value).ptr; }
+    static bool isNegative(float value) { return value < 0.0f; }
+    static bool isValid(float value) { return !std::isnan(value); }
+};
+
+template <>
+struct CoefficientTraits<double>
+{
+    using Accumulator = double;
+    static constexpr const char *NAME = "double";
+    static constexpr CoefficientType TYPE = CoefficientType::Double;
+
+    static double parse(const std::string &text) { return std::stod(text); }
+    static const char *scan(const char *first, const char *last, double &value) { return scanNumber(first, last, value); }
+    static char *formatTo(char *first, char *last, double value);
+    static char *printTo(char *first, char *last, double value) { return std::to_chars(first, last, value, std::chars_format::general, 6).ptr; }
+    static char *exactTo(char *first, char *last, double value) { return std::to_chars(first, last, value).ptr; }
+    static bool isNegative(double value) { return value < 0.0; }
+    static bool isValid(double value) { return !std::isnan(value); }
+};
+
+template <>
+struct CoefficientTraits<int64_t>
+{
+    using Accumulator = int64_t;
+    static constexpr const char *NAME = "int64";
+    static constexpr CoefficientType TYPE = CoefficientType::Int64;
+
+    static int64_t parse(const std::string &text) { return std::stoll(text); }
+    static const char *scan(const char *first, const char *last, int64_t &value) { return scanNumber(first, last, value); }
+    static char *formatTo(char *first, char *last, int64_t value) { return std::to_chars(first, last, value).ptr; }
+    static char *printTo(char *first, char *last, int64_t value) { return std::to_chars(first, last, value).ptr; }
+    static char *exactTo(char *first, char *last, int64_t value) { return std::to_chars(first, last, value).ptr; }
+    static bool isNegative(int64_t value) { return value < 0; }
+    static bool isValid(int64_t) { return true; }
+};
+
+template <>
+struct CoefficientTraits<ModInt>
+{
+    using Accumulator = ModInt;
+    static constexpr const char *NAME = "mod";
+    static constexpr CoefficientType TYPE = CoefficientType::Mod;
+
+    static ModInt parse(const std::string &text) { return ModInt((int64_t)std::stoll(text)); }
+    static const char *scan(const char *first, const char *last, ModInt &value)
+    {
+        int64_t integer;
+        const char *end = scanNumber(first, last, integer);
+        if (end != nullptr)
+            value = ModInt(integer);
+        return end;
+    }
+    static char *formatTo(char *first, char *last, ModInt value) { return std::to_chars(first, last, value.value()).ptr; }
+    static char *printTo(char *first, char *last, ModInt value) { return std::to_chars(first, last, value.value()).ptr; }
+    static char *exactTo(char *first, char *last, ModInt value) { return std::to_chars(first, last, value.value()).ptr; }
+    // Residues have no sign: every term is printed as a sum
+    static bool isNegative(ModInt) { return false; }
+    static bool isValid(ModInt) { return true; }
+};
+
+#endif // COEFFICIENT_H
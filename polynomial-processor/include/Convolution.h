@@ -0,0 +1,42 @@
+#ifndef CONVOLUTION_H
+#define CONVOLUTION_H
+
+#include <cstdint>
+
+// Transform used by convolutionMultiply
+enum class ConvolutionMode
+{
+    Ntt, // Exact number-theoretic transform for integer coefficients, FFT when that is not possible
+    Fft  // Complex floating-point FFT, always
+};
+
+// Primes usable by nttMultiplyModulo, all of the form c * 2^k + 1 with primitive root 3
+extern const uint32_t NTT_PRIMES[3];
+
+// Longest transform every NTT prime supports: 998244353 = 119 * 2^23 + 1 has roots of unity up to order 2^23
+constexpr int NTT_MAX_LENGTH = 1 << 23;
+
+// FFT product of two real coefficient arrays: out[0 .. n + m - 1) = a[0 .. n) * b[0 .. m)
+void fftMultiply(const double *a, int n, const double *b, int m, double *out);
+
+// FFT square of a real coefficient array, through transforms of half its length: out[0 .. 2n - 1) = a[0 .. n)^2
+void fftSquare(const double *a, int n, double *out);
+
+// Exact product of two integer-valued coefficient arrays through NTT and CRT; returns false if it cannot be exact
+bool nttMultiply(const double *a, int n, const double *b, int m, double *out);
+
+// Exact product of two integer coefficient arrays through NTT and CRT; returns false if it cannot be exact, or if a
+// coefficient of the product could reach 2^63
+bool nttMultiply(const int64_t *a, int n, const int64_t *b, int m, int64_t *out);
+
+// Product of two arrays of residues modulo one of NTT_PRIMES (a square, with a == b, is transformed once); returns
+// false if the product is longer than NTT_MAX_LENGTH
+bool nttMultiplyModulo(const uint32_t *a, int n, const uint32_t *b, int m, uint32_t *out, uint32_t modulus);
+
+// Product of two coefficient arrays through the transform selected by `mode`
+void convolutionMultiply(const double *a, int n, const double *b, int m, double *out, ConvolutionMode mode);
+
+// Square of a coefficient array through the transform selected by `mode`
+void convolutionSquare(const double *a, int n, double *out, ConvolutionMode mode);
+
+#endif // CONVOLUTION_H
@@ -0,0 +1,62 @@
+#ifndef DENSEPOLYNOMIAL_H
+#define DENSEPOLYNOMIAL_H
+
+#include "Coefficient.h"
+#include <cstddef>
+
+template <typename T>
+class BasicList;
+
+template <typename T>
+class BasicDensePolynomial
+{
+private:
+    T *coefficients;
+    int length;
+    int capacity;
+
+    // Helper methods (private)
+    static int blocksFor(int length);
+    void allocate(int minLength);
+    void release();
+    void trim();
+    void clearPadding();
+    void accumulate(const BasicDensePolynomial &other, bool subtract);
+
+public:
+    using Accumulator = typename CoefficientTraits<T>::Accumulator;
+
+    // Coefficients are stored in blocks of one 64-byte cache line
+    static constexpr std::size_t ALIGNMENT = 64;
+    static constexpr int BLOCK = (int)(ALIGNMENT / sizeof(T));
+
+    BasicDensePolynomial();
+    explicit BasicDensePolynomial(const BasicList<T> &list);
+    BasicDensePolynomial(const BasicDensePolynomial &other);
+    BasicDensePolynomial(BasicDensePolynomial &&other) noexcept;
+    ~BasicDensePolynomial();
+    BasicDensePolynomial &operator=(const BasicDensePolynomial &other);
+    BasicDensePolynomial &operator=(BasicDensePolynomial &&other) noexcept;
+
+    T getCoefficient(int degree) const;
+    void setCoefficient(int degree, T coefficient);
+    int getDegree() const;
+    int size() const;
+    bool isEmpty() const;
+    void clear();
+    const T *data() const;
+
+    BasicList<T> toList() const;
+
+    BasicDensePolynomial operator+(const BasicDensePolynomial &other) const;
+    BasicDensePolynomial operator-(const BasicDensePolynomial &other) const;
+    BasicDensePolynomial operator*(const BasicDensePolynomial &other) const;
+    BasicDensePolynomial operator*(T scalar) const;
+    BasicDensePolynomial &operator+=(const BasicDensePolynomial &other);
+    BasicDensePolynomial &operator-=(const BasicDensePolynomial &other);
+    BasicDensePolynomial &operator*=(T scalar);
+};
+
+using DensePolynomial = BasicDensePolynomial<float>;
+
+#endif // DENSEPOLYNOMIAL_H
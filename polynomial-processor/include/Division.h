@@ -0,0 +1,88 @@
+#ifndef DIVISION_H
+#define DIVISION_H
+
+#include "List.h"
+#include <cstdint>
+#include <vector>
+
+// Tunables used by the division kernels
+struct DivisionSettings
+{
+    // Quotient length below which the classical long division is used instead of Newton iteration
+    int newtonThreshold = 64;
+    // Degree of the smaller operand below which the GCD uses the classical Euclidean algorithm instead of half-GCD
+    int halfGcdThreshold = 256;
+    // Magnitude, relative to the largest coefficient of the operands, below which a floating-point remainder
+    // coefficient is taken as zero
+    double zeroTolerance = 1e-9;
+};
+
+// Returns the settings shared by every division
+DivisionSettings &divisionSettings();
+
+// The coefficient-vector kernels below are instantiated for the accumulator types: double, int64_t and ModInt
+
+// Truncated inverse of a power series: g such that f * g = 1 mod x^n (requires f[0] invertible)
+template <typename A>
+std::vector<A> seriesInverse(const std::vector<A> &f, int n);
+
+// Classical long division of coefficient vectors (indexed by degree); returns false if a step is not exact (int64_t)
+template <typename A>
+bool longDivide(const std::vector<A> &a, const std::vector<A> &b,
+                std::vector<A> &quotient, std::vector<A> &remainder);
+
+// Division of coefficient vectors through a Newton-iteration reciprocal and fast multiplication
+template <typename A>
+bool divideCoefficients(const std::vector<A> &a, const std::vector<A> &b,
+                        std::vector<A> &quotient, std::vector<A> &remainder);
+
+// Reciprocal of the reversed divisor, rev(b)^-1 mod x^n, shared by many divisions by b
+template <typename A>
+std::vector<A> reversedInverse(const std::vector<A> &b, int n);
+
+// Division of coefficient vectors with the reciprocal of the divisor computed beforehand by reversedInverse
+template <typename A>
+bool divideCoefficients(const std::vector<A> &a, const std::vector<A> &b, const std::vector<A> &inverse,
+                        std::vector<A> &quotient, std::vector<A> &remainder);
+
+// Divisor shared by many reductions, such as those of a modular power, with the reciprocal they all use
+template <typename A>
+class Modulus
+{
+public:
+    // The reciprocal covers quotients of up to deg m - 1 coefficients: those of squares and products of remainders
+    explicit Modulus(std::vector<A> m);
+
+    // Coefficients of m, indexed by degree
+    const std::vector<A> &coefficients() const { return divisor; }
+
+    // Replaces p with p mod m, trimmed; returns false if the division is not exact (int64_t)
+    bool reduce(std::vector<A> &p) const;
+
+    // Sets power to x^exponent mod m by repeated squaring; returns false if a reduction is not exact (int64_t)
+    bool monomial(uint64_t exponent, std::vector<A> &power) const;
+
+private:
+    std::vector<A> divisor;
+    std::vector<A> inverse;
+};
+
+// Greatest common divisor of coefficient vectors: monic over a field, primitive with a positive leading
+// coefficient for int64_t; returns false if an int64_t intermediate would overflow
+template <typename A>
+bool gcdCoefficients(const std::vector<A> &a, const std::vector<A> &b, std::vector<A> &gcd);
+
+// Quotient and remainder of two polynomials; returns false if the divisor is zero or the division is not exact (int64_t)
+template <typename T>
+bool dividePolynomials(const BasicList<T> &a, const BasicList<T> &b, BasicList<T> &quotient, BasicList<T> &remainder);
+
+// Remainder of two polynomials, without the quotient a sparse dividend of large degree would need; returns false
+// like dividePolynomials
+template <typename T>
+bool polynomialRemainder(const BasicList<T> &a, const BasicList<T> &b, BasicList<T> &remainder);
+
+// Greatest common divisor of two polynomials (see gcdCoefficients); returns false if it cannot be computed exactly
+template <typename T>
+bool polynomialGcd(const BasicList<T> &a, const BasicList<T> &b, BasicList<T> &gcd);
+
+#endif // DIVISION_H
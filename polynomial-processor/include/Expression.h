@@ -0,0 +1,33 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include "List.h"
+#include <string>
+#include <vector>
+
+template <typename T>
+class BasicExpression
+{
+private:
+    // One signed product of operands, e.g. "- c * d"
+    struct Product
+    {
+        T sign;
+        std::vector<int> factors;
+    };
+
+    std::vector<Product> products;
+    std::vector<BasicList<T>> operands;
+
+public:
+    bool parse(const std::string &text);
+    int operandCount() const;
+    BasicList<T> &operand(int index);
+    const BasicList<T> &operand(int index) const;
+    void evaluateInto(BasicList<T> &destination) const;
+    void reset();
+};
+
+using Expression = BasicExpression<float>;
+
+#endif // EXPRESSION_H
@@ -1,9 +1,31 @@
 #ifndef FILEPROCESSOR_H
 #define FILEPROCESSOR_H
 
+#include <iostream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include "List.h"
+#include "LineReader.h"
+#include "Expression.h"
+#include "OutputBuffer.h"
+
+// Form in which the results of the commands are printed
+enum class OutputFormat
+{
+    Pretty, // Sentences with the polynomials in readable form (x², x³, ...), the default
+    Pairs,  // One line per result: polynomials as `coefficient degree` pairs, numbers in their shortest exact form
+    Binary  // One record per result in the binary form of BinaryFormat.h, after its header
+};
+
+struct OutputSettings
+{
+    OutputFormat format = OutputFormat::Pretty;
+};
+
+// Returns the settings shared by every command
+OutputSettings &outputSettings();
 
 // Trims leading and trailing whitespace from a string
 std::string trim(const std::string &str);
@@ -12,15 +34,50 @@ std::string trim(const std::string &str);
 std::vector<std::string> trimFileLines(const std::string &filename);
 
 // Extracts the command character from a line
-void getCommand(const std::string &line, char *command);
+void getCommand(std::string_view line, char *command);
+
+// Parses the coefficient and degree pairs of a line in place; returns 0, or the column of the first malformed pair
+template <typename T>
+size_t parseTerms(std::string_view line, std::vector<std::pair<int, T>> &terms);
+
+// Populates a polynomial from a line containing coefficient and degree pairs; returns false if the line is empty
+template <typename T>
+bool populatePolynomial(std::string_view line, BasicList<T> &poly);
+
+// Parses a line of whitespace-separated evaluation points; returns false if the line holds no valid value
+template <typename T>
+bool populatePoints(std::string_view line, std::vector<T> &points);
+
+// Processes a single command with the given polynomials and optional evaluation point(s), expression or exponent
+template <typename T>
+void processLine(char command, BasicList<T> &poly1, BasicList<T> &poly2, const T *x = nullptr,
+                 const std::vector<T> &points = std::vector<T>(), BasicExpression<T> *expression = nullptr,
+                 const int64_t *exponent = nullptr, OutputBuffer &out = standardOutput());
+
+// Processes the entire file by streaming its lines and executing each command as soon as its operands are read
+// (with jobs > 1, up to `jobs` command blocks run at once and their results are printed in input order);
+// a file in the binary form is mapped and run without text parsing
+template <typename T>
+void processFile(const std::string &filePath, int jobs = 1);
+
+// Processes the entire file with polynomials of the given coefficient type (the type stored in a binary file wins)
+void processFile(const std::string &filePath, CoefficientType type, int jobs = 1);
+
+// Runs the command blocks of one request read from a client connection, up to the end of its frame
+template <typename T>
+void processRequest(LineReader &reader, OutputBuffer &out);
+
+// Converts a command file between the text and the binary form (the direction follows the form of the input)
+template <typename T>
+void convertFile(const std::string &inputPath, const std::string &outputPath);
 
-// Populates a polynomial from a line containing coefficient and degree pairs
-void populatePolynomial(const std::string &line, List &poly);
+// Converts a command file, with coefficients of the given type when the input is text
+void convertFile(const std::string &inputPath, const std::string &outputPath, CoefficientType type);
 
-// Processes a single command with the given polynomials and optional evaluation point
-void processLine(char command, List &poly1, List &poly2, float x = NAN);
+// Parses the name of an output format ("pretty", "pairs" or "binary")
+bool parseOutputFormat(const std::string &name, OutputFormat &format);
 
-// Processes the entire file by reading commands and executing them
-void processFile(const std::string &filePath);
+// Parses the name of a coefficient type ("float", "double", "int64" or "mod")
+bool parseCoefficientType(const std::string &name, CoefficientType &type);
 
 #endif // FILEPROCESSOR_H
@@ -0,0 +1,107 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Parts of the processing of a command block that are timed separately
+enum class Phase
+{
+    Parse,   // Reading the lines of the block and parsing its operands
+    Compute, // The List operators and evaluations
+    Format   // Writing the results
+};
+
+constexpr int PHASE_COUNT = 3;
+
+struct InstrumentationSettings
+{
+    // Prints a summary with a latency histogram per command at exit
+    bool stats = false;
+    // Writes every timed phase to this file in the Chrome trace-event format, if not empty
+    std::string tracePath;
+
+    bool enabled() const { return stats || !tracePath.empty(); }
+};
+
+// Returns the settings of the instrumentation, set from the command line
+InstrumentationSettings &instrumentationSettings();
+
+// One timed phase of a command block
+struct PhaseRecord
+{
+    int64_t start = -1;   // Nanoseconds since the start of the program at the first entry, or -1 if not entered
+    int64_t duration = 0; // Nanoseconds spent in the phase, over every entry
+    uint64_t nodes = 0;   // List nodes created during the phase
+    int thread = 0;       // Small number of the thread that ran it
+};
+
+// Measurements of one command block, filled while it is read and run
+struct CommandRecord
+{
+    char command = '\0';
+    std::size_t line = 0;
+    PhaseRecord phases[PHASE_COUNT];
+    int64_t resultTerms = 0;
+
+    void clear() { *this = CommandRecord(); }
+};
+
+// Makes a record the target of the phases timed on the calling thread while it is alive
+// (does nothing while the instrumentation is disabled)
+class CommandScope
+{
+private:
+    CommandRecord *previous;
+
+public:
+    explicit CommandScope(CommandRecord &record);
+    ~CommandScope();
+    CommandScope(const CommandScope &other) = delete;
+    CommandScope &operator=(const CommandScope &other) = delete;
+};
+
+// Adds the time and node allocations of its lifetime to a phase of the record of the calling thread
+class PhaseTimer
+{
+private:
+    CommandRecord *record;
+    Phase phase;
+    int64_t start;
+    std::size_t nodes;
+
+public:
+    explicit PhaseTimer(Phase phase);
+    ~PhaseTimer();
+    PhaseTimer(const PhaseTimer &other) = delete;
+    PhaseTimer &operator=(const PhaseTimer &other) = delete;
+};
+
+// Writes its lifetime to the trace as a span of its own, such as a whole processFile run
+class SpanTimer
+{
+private:
+    const char *name;
+    int64_t start;
+
+public:
+    explicit SpanTimer(const char *name);
+    ~SpanTimer();
+    SpanTimer(const SpanTimer &other) = delete;
+    SpanTimer &operator=(const SpanTimer &other) = delete;
+};
+
+// Sets the number of terms of the result in the record of the calling thread
+void recordResultTerms(int64_t terms);
+
+// Adds a finished block to the statistics and the trace
+void finishCommand(const CommandRecord &record);
+
+// Opens the trace file; returns false if it cannot be created
+bool startInstrumentation();
+
+// Prints the summary (with --stats) and completes the trace file
+void finishInstrumentation();
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,46 @@
+#ifndef LINEREADER_H
+#define LINEREADER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class LineReader
+{
+private:
+    int descriptor;
+    bool ownsDescriptor;
+    bool endOfInput;
+    std::vector<char> buffer;
+    std::size_t begin;
+    std::size_t end;
+    std::size_t lines;
+    std::string frameEnd;
+    bool frameEnded;
+
+    // Helper methods (private)
+    bool refill();
+
+public:
+    // Initial size of the read buffer; it only grows to hold a line longer than that
+    static constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+    explicit LineReader(const std::string &path);
+    explicit LineReader(int descriptor);
+    ~LineReader();
+    LineReader(const LineReader &other) = delete;
+    LineReader &operator=(const LineReader &other) = delete;
+
+    bool isOpen() const;
+    bool next(std::string_view &line);
+    std::size_t lineCount() const;
+    bool hasBufferedInput() const;
+
+    // Frames: with a frame end set, `next` stops at a line equal to it until `nextFrame` is called
+    void setFrameEnd(const std::string &line);
+    bool atFrameEnd() const;
+    void nextFrame();
+};
+
+#endif // LINEREADER_H
@@ -2,51 +2,118 @@
 #define LIST_H
 
 #include "Node.h"
+#include "NodePool.h"
+#include "DensePolynomial.h"
+#include "OutputBuffer.h"
 #include <tuple>
 #include <iostream>
-#include <cmath>
+#include <string>
+#include <cstddef>
+#include <vector>
 
-class List
+// Thresholds used by List to pick its storage
+struct StorageSettings
+{
+    // Minimum number of terms before a list may switch to dense storage
+    int minDenseTerms = 64;
+    // Density (terms / (degree + 1)) at or above which a linked list switches to dense storage
+    float denseRatio = 0.5f;
+    // Density below which a dense list switches back to linked storage
+    float sparseRatio = 0.25f;
+};
+
+// Returns the settings shared by every list
+StorageSettings &storageSettings();
+
+template <typename T>
+class BasicList
 {
 private:
-    Node *head;
-    Node *tail;
+    using Node = BasicNode<T>;
+    using Traits = CoefficientTraits<T>;
+
+    // With linked storage the terms live in the node chain. With dense storage they live in `dense`,
+    // and the node chain is only a read-only view that the const accessors rebuild on demand.
+    mutable Node *head;
+    mutable Node *tail;
     int listSize;
+    mutable BasicNodePool<T> pool;
+    BasicDensePolynomial<T> dense;
+    bool denseStorage;
+    mutable bool viewValid;
 
     // Helper methods (private)
     void clear();
-    void copyFrom(const List &other);
-    std::string formatPrecision(float coeff) const;
-    std::string toString(float x = NAN) const;
-    std::string toSuperscript(int degree) const;
-
+    void buildView() const;
+    void invalidateView();
+    void toDense();
+    void toSparse();
+    void adaptStorage();
+    bool fitsDense(const BasicList &other) const;
+    void accumulateDense(const BasicList &other, T sign);
+    void copyFrom(const BasicList &other);
+    std::string toString(const T *x = nullptr) const;
+    static void writeSuperscript(OutputBuffer &out, int number);
+    BasicList merge(const BasicList &other, T sign) const;
+    void mergeInto(const BasicList &other, T sign);
 
 public:
-    List();
-    List(const List &other);
-    ~List();
-    List &operator=(const List &other);
+    using Accumulator = typename Traits::Accumulator;
+
+    // Number of points evaluated together by evaluateMany
+    static constexpr size_t EVALUATION_BLOCK = 64;
+
+    BasicList();
+    explicit BasicList(const BasicDensePolynomial<T> &poly);
+    explicit BasicList(BasicDensePolynomial<T> &&poly);
+    BasicList(const BasicList &other);
+    BasicList(BasicList &&other) noexcept;
+    ~BasicList();
+    BasicList &operator=(const BasicList &other);
+    BasicList &operator=(BasicList &&other) noexcept;
 
-    void insert(float coefficient, int degree);
+    void insert(T coefficient, int degree);
+    void append(T coefficient, int degree);
+    void reserve(int terms);
     void remove(int degree);
     bool exists(int degree) const;
     int size() const;
     bool isEmpty() const;
+    void reset();
     Node *search(int degree) const;
     Node *getHead() const;
     Node *getNext(Node *node) const;
-    std::tuple<float, int> getValues(int degree) const;
+    std::tuple<T, int> getValues(int degree) const;
 
     int getDegree() const;
-    void evaluate(float x);
-    void showALL(bool endl = true) const;
-    friend std::ostream &operator<<(std::ostream &os, const List &list);
+    bool isDenseStorage() const;
+    const BasicDensePolynomial<T> &getDenseStorage() const;
+    std::vector<Accumulator> getCoefficients() const;
+    static BasicList fromCoefficients(const std::vector<Accumulator> &coefficients);
+    uint64_t hash(uint64_t seed = 0) const;
+    void evaluate(T x, OutputBuffer &out = standardOutput());
+    T evaluateAt(T x) const;
+    void evaluateMany(const T *xs, T *out, size_t n) const;
+    void showALL(bool endl = true, OutputBuffer &out = standardOutput()) const;
+    void format(OutputBuffer &out, const T *x = nullptr) const;
+    void formatPairs(OutputBuffer &out) const;
+    template <typename U>
+    friend std::ostream &operator<<(std::ostream &os, const BasicList<U> &list);
 
-    void changeNode(int currentDegree, float coefficient, int degree);
+    void changeNode(int currentDegree, T coefficient, int degree);
 
-    List operator+(const List &other) const;
-    List operator-(const List &other) const;
-    List operator*(const List &other) const;
+    BasicList operator+(const BasicList &other) const &;
+    BasicList operator+(const BasicList &other) &&;
+    BasicList operator-(const BasicList &other) const &;
+    BasicList operator-(const BasicList &other) &&;
+    BasicList operator*(const BasicList &other) const;
+    BasicList &operator+=(const BasicList &other);
+    BasicList &operator-=(const BasicList &other);
 };
 
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const BasicList<T> &list);
+
+using List = BasicList<float>;
+
 #endif // LIST_H
@@ -0,0 +1,84 @@
+#ifndef MODINT_H
+#define MODINT_H
+
+#include <cstdint>
+#include <iostream>
+
+class ModInt
+{
+public:
+    // Prime modulus; it is also the first NTT prime, so products can go straight through the NTT
+    static constexpr uint32_t MODULUS = 998244353u;
+
+private:
+    // Montgomery form of the value: value * 2^32 mod MODULUS
+    uint32_t residue;
+
+    // -MODULUS^-1 mod 2^32, by Newton iteration (each step doubles the number of correct bits)
+    static constexpr uint32_t NEGATED_INVERSE = []
+    {
+        uint32_t inverse = MODULUS;
+        for (int i = 0; i < 4; i++)
+            inverse *= 2u - MODULUS * inverse;
+        return 0u - inverse;
+    }();
+    // 2^64 mod MODULUS, used to move a value into Montgomery form
+    static constexpr uint32_t R2 = (uint32_t)((0ull - MODULUS) % MODULUS);
+
+public:
+    constexpr ModInt() : residue(0) {}
+    constexpr ModInt(int64_t value) : residue(0)
+    {
+        int64_t reduced = value % (int64_t)MODULUS;
+        if (reduced < 0)
+            reduced += MODULUS;
+        residue = reduce((uint64_t)reduced * R2);
+    }
+
+    // Montgomery reduction: returns t * 2^-32 mod MODULUS for t < MODULUS * 2^32
+    static constexpr uint32_t reduce(uint64_t t)
+    {
+        uint32_t m = (uint32_t)t * NEGATED_INVERSE;
+        uint32_t u = (uint32_t)((t + (uint64_t)m * MODULUS) >> 32);
+        return u >= MODULUS ? u - MODULUS : u;
+    }
+
+    // Wraps a residue that is already in Montgomery form
+    static constexpr ModInt fromMontgomery(uint32_t residue)
+    {
+        ModInt result;
+        result.residue = residue;
+        return result;
+    }
+
+    constexpr uint32_t montgomery() const { return residue; }
+    constexpr uint32_t value() const { return reduce(residue); }
+
+    constexpr ModInt operator+(ModInt other) const
+    {
+        uint32_t sum = residue + other.residue;
+        return fromMontgomery(sum >= MODULUS ? sum - MODULUS : sum);
+    }
+    constexpr ModInt operator-(ModInt other) const
+    {
+        return fromMontgomery(residue >= other.residue ? residue - other.residue : residue + MODULUS - other.residue);
+    }
+    constexpr ModInt operator*(ModInt other) const
+    {
+        return fromMontgomery(reduce((uint64_t)residue * other.residue));
+    }
+    constexpr ModInt operator-() const { return fromMontgomery(residue == 0 ? 0 : MODULUS - residue); }
+    ModInt &operator+=(ModInt other) { return *this = *this + other; }
+    ModInt &operator-=(ModInt other) { return *this = *this - other; }
+    ModInt &operator*=(ModInt other) { return *this = *this * other; }
+    constexpr bool operator==(ModInt other) const { return residue == other.residue; }
+    constexpr bool operator!=(ModInt other) const { return residue != other.residue; }
+
+    ModInt pow(uint64_t exponent) const;
+    ModInt inverse() const;
+
+    friend std::ostream &operator<<(std::ostream &os, ModInt value);
+    friend std::istream &operator>>(std::istream &is, ModInt &value);
+};
+
+#endif // MODINT_H
@@ -0,0 +1,77 @@
+#ifndef MULTIPLICATION_H
+#define MULTIPLICATION_H
+
+#include "List.h"
+#include "Convolution.h"
+#include <vector>
+
+// Tunables used by List::operator* to pick a multiplication kernel
+struct MultiplicationSettings
+{
+    // Operand length at or below which Karatsuba falls back to the schoolbook kernel
+    int karatsubaThreshold = 32;
+    // Length of the shorter operand from which the FFT/NTT convolution engine is used
+    int convolutionThreshold = 512;
+    // Transform used by the convolution engine
+    ConvolutionMode convolutionMode = ConvolutionMode::Ntt;
+    // Number of worker threads a single product may use (1 keeps every product on the calling thread)
+    int threads = 1;
+    // Number of coefficient products (n * m) below which a product stays on one thread
+    long long parallelThreshold = 1 << 20;
+};
+
+// Returns the settings shared by every multiplication
+MultiplicationSettings &multiplicationSettings();
+
+// Checks whether a polynomial is dense enough for the coefficient-array kernels, by the density at which lists
+// switch to dense storage (StorageSettings::denseRatio)
+template <typename T>
+bool isDense(const BasicList<T> &poly);
+
+// The coefficient-array kernels below are instantiated for the accumulator types: double, int64_t and ModInt
+
+// Schoolbook product of two coefficient arrays: out[0 .. n + m - 1) = a[0 .. n) * b[0 .. m)
+template <typename A>
+void schoolbookMultiply(const A *a, int n, const A *b, int m, A *out);
+
+// Schoolbook square of a coefficient array, each cross product computed once: out[0 .. 2n - 1) = a[0 .. n)^2
+template <typename A>
+void schoolbookSquare(const A *a, int n, A *out);
+
+// Karatsuba product of two coefficient arrays, with the same contract as schoolbookMultiply
+template <typename A>
+void karatsubaMultiply(const A *a, int n, const A *b, int m, A *out);
+
+// Karatsuba square of a coefficient array, with the same contract as schoolbookSquare
+template <typename A>
+void karatsubaSquare(const A *a, int n, A *out);
+
+// Product of two coefficient arrays through the fastest kernel for their size and type
+template <typename A>
+void multiplyCoefficients(const A *a, int n, const A *b, int m, A *out);
+
+// Square of a coefficient array through the fastest square kernel for its size and type
+template <typename A>
+void squareCoefficients(const A *a, int n, A *out);
+
+// Product of two coefficient arrays split into tiles that run on up to `threads` workers
+template <typename A>
+void parallelMultiplyCoefficients(const A *a, int n, const A *b, int m, A *out, int threads);
+
+// Product of two coefficient vectors (indexed by degree) through multiplyCoefficients
+template <typename A>
+std::vector<A> multiplyVectors(const std::vector<A> &a, const std::vector<A> &b);
+
+// Square of a coefficient vector (indexed by degree) through squareCoefficients
+template <typename A>
+std::vector<A> squareVectors(const std::vector<A> &a);
+
+// Multiplies two polynomials through the coefficient-array kernels
+template <typename T>
+BasicList<T> denseMultiply(const BasicList<T> &a, const BasicList<T> &b);
+
+// Multiplies two sparse polynomials with a heap merge of the partial products (Johnson's algorithm)
+template <typename T>
+BasicList<T> sparseMultiply(const BasicList<T> &a, const BasicList<T> &b);
+
+#endif // MULTIPLICATION_H
@@ -1,23 +1,35 @@
 #ifndef NODE_H
 #define NODE_H
 
-class Node
+#include "Coefficient.h"
+
+template <typename T>
+class BasicList;
+
+template <typename T>
+class BasicNodePool;
+
+template <typename T>
+class BasicNode
 {
 private:
-    float coefficient;
+    T coefficient;
     int degree;
-    Node *next;
+    BasicNode *next;
 
 public:
     // Constructor
-    Node(float coeff, int deg);
+    BasicNode(T coeff, int deg);
 
     // Getters
-    float getCoefficient() const;
+    T getCoefficient() const;
     int getDegree() const;
-    Node *getNext() const;
+    BasicNode *getNext() const;
 
-    friend class List;
+    friend class BasicList<T>;
+    friend class BasicNodePool<T>;
 };
 
+using Node = BasicNode<float>;
+
 #endif // NODE_H
@@ -0,0 +1,54 @@
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include "Node.h"
+#include <cstddef>
+
+template <typename T>
+class BasicNodePool
+{
+private:
+    struct Chunk
+    {
+        Chunk *next;
+        std::size_t capacity;
+    };
+
+    using Node = BasicNode<T>;
+
+    Chunk *chunks;
+    Node *freeList;
+    Node *cursor;
+    Node *limit;
+    std::size_t nextCapacity;
+
+    // Helper methods (private)
+    void addChunk(std::size_t capacity);
+    static Node *firstSlot(Chunk *chunk);
+
+public:
+    // Capacity of the first chunk and upper bound for the geometric growth of the next ones
+    static constexpr std::size_t MIN_CHUNK = 16;
+    static constexpr std::size_t MAX_CHUNK = 65536;
+
+    BasicNodePool();
+    ~BasicNodePool();
+    BasicNodePool(const BasicNodePool &other) = delete;
+    BasicNodePool &operator=(const BasicNodePool &other) = delete;
+    BasicNodePool(BasicNodePool &&other) noexcept;
+    BasicNodePool &operator=(BasicNodePool &&other) noexcept;
+
+    Node *create(T coefficient, int degree);
+    void destroy(Node *node);
+    void reserve(std::size_t count);
+    void reset();
+    void release();
+
+    static std::size_t allocationCount();
+    static std::size_t nodeCount();
+    static std::size_t threadNodeCount();
+};
+
+using NodePool = BasicNodePool<float>;
+
+#endif // NODEPOOL_H
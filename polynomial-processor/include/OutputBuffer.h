@@ -0,0 +1,86 @@
+#ifndef OUTPUTBUFFER_H
+#define OUTPUTBUFFER_H
+
+#include "Coefficient.h"
+#include <charconv>
+#include <cstddef>
+#include <iosfwd>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+class OutputBuffer
+{
+private:
+    std::vector<char> data;
+    std::size_t used;
+    int descriptor;
+
+    // Helper methods (private)
+    char *reserve(std::size_t count);
+
+public:
+    // Size at which a buffer attached to a descriptor writes its contents out
+    static constexpr std::size_t FLUSH_SIZE = 1 << 20;
+
+    explicit OutputBuffer(int descriptor = -1);
+    ~OutputBuffer();
+    OutputBuffer(const OutputBuffer &other) = delete;
+    OutputBuffer &operator=(const OutputBuffer &other) = delete;
+
+    OutputBuffer &operator<<(std::string_view text);
+    OutputBuffer &operator<<(char c);
+    OutputBuffer &write(const void *bytes, std::size_t count);
+
+    // Integers in decimal, without going through a stream
+    template <typename I, typename = std::enable_if_t<std::is_integral_v<I>>>
+    OutputBuffer &operator<<(I value)
+    {
+        char *first = reserve(24);
+        used = std::to_chars(first, first + 24, value).ptr - data.data();
+        return *this;
+    }
+
+    // Coefficient as printed in a polynomial (see CoefficientTraits::formatTo)
+    template <typename T>
+    OutputBuffer &writeCoefficient(T value)
+    {
+        char *first = reserve(MAX_NUMBER_LENGTH);
+        used = CoefficientTraits<T>::formatTo(first, first + MAX_NUMBER_LENGTH, value) - data.data();
+        return *this;
+    }
+
+    // Value as std::ostream prints it (see CoefficientTraits::printTo)
+    template <typename T>
+    OutputBuffer &writeValue(T value)
+    {
+        char *first = reserve(MAX_NUMBER_LENGTH);
+        used = CoefficientTraits<T>::printTo(first, first + MAX_NUMBER_LENGTH, value) - data.data();
+        return *this;
+    }
+
+    // Shortest text that parses back to the same value (see CoefficientTraits::exactTo)
+    template <typename T>
+    OutputBuffer &writeExact(T value)
+    {
+        char *first = reserve(MAX_NUMBER_LENGTH);
+        used = CoefficientTraits<T>::exactTo(first, first + MAX_NUMBER_LENGTH, value) - data.data();
+        return *this;
+    }
+
+    void flush();
+    void clear();
+    std::size_t size() const;
+    std::string_view view() const;
+};
+
+// Buffer attached to the standard output, shared by every command
+OutputBuffer &standardOutput();
+
+// Stream receiving the error messages of the calling thread: std::cerr, unless redirected
+std::ostream &errorOutput();
+
+// Sends the error messages of the calling thread to a stream (nullptr restores std::cerr)
+void redirectErrors(std::ostream *stream);
+
+#endif // OUTPUTBUFFER_H
@@ -0,0 +1,16 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include "List.h"
+#include <cstdint>
+
+// p^k by repeated squaring; returns false if the degree of the result does not fit in an int
+template <typename T>
+bool polynomialPower(const BasicList<T> &p, uint64_t k, BasicList<T> &power);
+
+// p^k mod m by repeated squaring, reduced after every step; returns false if m is zero or a reduction is not
+// exact (int64_t)
+template <typename T>
+bool polynomialPowerMod(const BasicList<T> &p, uint64_t k, const BasicList<T> &m, BasicList<T> &power);
+
+#endif // POWER_H
@@ -0,0 +1,109 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include "List.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct CacheSettings
+{
+    // Whether processLine looks results up before computing them
+    bool enabled = false;
+    // Total number of terms the cached results may hold before the least recently used are evicted
+    std::size_t maxTerms = std::size_t(1) << 22;
+    // File the cache is loaded from at the first lookup and saved to at exit, if not empty
+    std::string path;
+};
+
+// Returns the settings of the result caches, set from the command line
+CacheSettings &cacheSettings();
+
+// Identity of an operand in the cache: two hashes of it with independent seeds (BasicList::hash), so a
+// hit needs a different polynomial to collide with the operand under both
+struct CacheOperand
+{
+    uint64_t hash;
+    uint64_t check;
+
+    bool operator==(const CacheOperand &other) const { return hash == other.hash && check == other.check; }
+    bool operator<(const CacheOperand &other) const { return hash != other.hash ? hash < other.hash : check < other.check; }
+};
+
+// Returns the identity of a polynomial as a cache operand
+template <typename T>
+CacheOperand cacheOperand(const BasicList<T> &p);
+
+template <typename T>
+class BasicResultCache
+{
+private:
+    // Command and identities of its operands
+    struct Key
+    {
+        char command;
+        CacheOperand first;
+        CacheOperand second;
+
+        bool operator==(const Key &other) const
+        {
+            return command == other.command && first == other.first && second == other.second;
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const
+        {
+            return (std::size_t)(key.first.hash * 31 + key.second.hash) ^ (std::size_t)key.command;
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        std::shared_ptr<const BasicList<T>> result;
+    };
+
+    // Most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<Key, typename std::list<Entry>::iterator, KeyHash> index;
+    std::size_t terms;
+    std::size_t maxTerms;
+    uint64_t hits;
+    uint64_t misses;
+    mutable std::mutex mutex;
+
+    // Helper methods (private)
+    void store(const Key &key, std::shared_ptr<const BasicList<T>> result);
+
+public:
+    explicit BasicResultCache(std::size_t maxTerms);
+    BasicResultCache(const BasicResultCache &other) = delete;
+    BasicResultCache &operator=(const BasicResultCache &other) = delete;
+
+    std::shared_ptr<const BasicList<T>> find(char command, const CacheOperand &first, const CacheOperand &second);
+    void insert(char command, const CacheOperand &first, const CacheOperand &second, std::shared_ptr<const BasicList<T>> result);
+    void clear();
+
+    uint64_t hitCount() const;
+    uint64_t missCount() const;
+    std::size_t size() const;
+    std::size_t termCount() const;
+
+    bool load(const std::string &path);
+    bool save(const std::string &path) const;
+};
+
+// Returns the process-wide cache of results with coefficients of type T, loaded from `cacheSettings().path` on first use
+template <typename T>
+BasicResultCache<T> &resultCache();
+
+// Saves every cache that was used to `cacheSettings().path` and, if `printStats`, prints their hit and miss counters
+void finishResultCaches(bool printStats);
+
+#endif // RESULTCACHE_H
@@ -0,0 +1,14 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "Coefficient.h"
+#include <string>
+
+// Line that ends each request of a client
+constexpr const char *REQUEST_END = ".";
+
+// Serves requests on the standard input and output ("-") or on a Unix socket at the given path, until the input
+// ends or the process is interrupted; returns false if the socket cannot be opened
+bool serve(const std::string &address, CoefficientType type);
+
+#endif // SERVER_H
@@ -0,0 +1,156 @@
+#ifndef STATICPOLYNOMIAL_H
+#define STATICPOLYNOMIAL_H
+
+#include "List.h"
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @class StaticPolynomial
+ * @brief Polynomial of degree at most N with its coefficients in a std::array, indexed by degree.
+ *
+ * Meant for small polynomials known at build time, such as the approximation polynomials of hot
+ * inner loops. Every arithmetic operation is `constexpr` and has no heap allocation, so a
+ * polynomial built from constants folds into constants, and evaluation is unrolled over the
+ * N + 1 coefficients at compile time. The converters to and from `BasicList<T>` are the only
+ * runtime-only members.
+ */
+template <std::size_t N, typename T = float>
+class StaticPolynomial
+{
+private:
+    std::array<T, N + 1> coefficients;
+
+    // Helper that applies Horner's rule with one expression per coefficient, highest degree first
+    template <std::size_t... I>
+    constexpr T horner([[maybe_unused]] T x, std::index_sequence<I...>) const
+    {
+        T result = coefficients[N];
+        ((result = result * x + coefficients[N - 1 - I]), ...);
+        return result;
+    }
+
+public:
+    static constexpr std::size_t DEGREE = N;
+
+    // Zero polynomial
+    constexpr StaticPolynomial() : coefficients{} {}
+
+    // Coefficients from degree 0 upwards; the missing ones are zero
+    template <typename... U>
+    constexpr StaticPolynomial(T first, U... rest) : coefficients{first, T(rest)...}
+    {
+        static_assert(sizeof...(U) <= N, "StaticPolynomial: more than N + 1 coefficients");
+    }
+
+    constexpr T operator[](std::size_t degree) const { return coefficients[degree]; }
+    constexpr T &operator[](std::size_t degree) { return coefficients[degree]; }
+
+    // Evaluates the polynomial at x with Horner's rule, unrolled over every coefficient
+    constexpr T operator()(T x) const { return horner(x, std::make_index_sequence<N>()); }
+    constexpr T evaluate(T x) const { return horner(x, std::make_index_sequence<N>()); }
+
+    // Highest degree with a non-zero coefficient (0 for the zero polynomial)
+    constexpr int getDegree() const
+    {
+        for (std::size_t degree = N; degree > 0; degree--)
+        {
+            if (coefficients[degree] != T(0))
+                return (int)degree;
+        }
+        return 0;
+    }
+
+    // Derivative, one degree lower (a constant stays a constant)
+    constexpr StaticPolynomial<(N > 0 ? N - 1 : 0), T> derivative() const
+    {
+        StaticPolynomial<(N > 0 ? N - 1 : 0), T> result;
+        for (std::size_t degree = 1; degree <= N; degree++)
+            result[degree - 1] = coefficients[degree] * T((int64_t)degree);
+        return result;
+    }
+
+    // Sum and difference, with the degree bound of the larger operand
+    template <std::size_t M>
+    constexpr StaticPolynomial<(N > M ? N : M), T> operator+(const StaticPolynomial<M, T> &other) const
+    {
+        StaticPolynomial<(N > M ? N : M), T> result;
+        for (std::size_t degree = 0; degree <= N; degree++)
+            result[degree] = coefficients[degree];
+        for (std::size_t degree = 0; degree <= M; degree++)
+            result[degree] = result[degree] + other[degree];
+        return result;
+    }
+
+    template <std::size_t M>
+    constexpr StaticPolynomial<(N > M ? N : M), T> operator-(const StaticPolynomial<M, T> &other) const
+    {
+        StaticPolynomial<(N > M ? N : M), T> result;
+        for (std::size_t degree = 0; degree <= N; degree++)
+            result[degree] = coefficients[degree];
+        for (std::size_t degree = 0; degree <= M; degree++)
+            result[degree] = result[degree] - other[degree];
+        return result;
+    }
+
+    // Product, with degree bound N + M (schoolbook; N and M are small by design)
+    template <std::size_t M>
+    constexpr StaticPolynomial<N + M, T> operator*(const StaticPolynomial<M, T> &other) const
+    {
+        StaticPolynomial<N + M, T> result;
+        for (std::size_t i = 0; i <= N; i++)
+        {
+            for (std::size_t j = 0; j <= M; j++)
+                result[i + j] = result[i + j] + coefficients[i] * other[j];
+        }
+        return result;
+    }
+
+    constexpr StaticPolynomial operator*(T scalar) const
+    {
+        StaticPolynomial result;
+        for (std::size_t degree = 0; degree <= N; degree++)
+            result[degree] = coefficients[degree] * scalar;
+        return result;
+    }
+
+    constexpr bool operator==(const StaticPolynomial &other) const
+    {
+        for (std::size_t degree = 0; degree <= N; degree++)
+        {
+            if (coefficients[degree] != other.coefficients[degree])
+                return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const StaticPolynomial &other) const { return !(*this == other); }
+
+    // Converts to a linked polynomial with every non-zero coefficient
+    BasicList<T> toList() const
+    {
+        BasicList<T> list;
+        for (std::size_t degree = N + 1; degree-- > 0;)
+        {
+            if (coefficients[degree] != T(0))
+                list.append(coefficients[degree], (int)degree);
+        }
+        return list;
+    }
+
+    // Copies a linked polynomial; returns false (leaving `out` untouched) if its degree exceeds N
+    static bool fromList(const BasicList<T> &list, StaticPolynomial &out)
+    {
+        if (!list.isEmpty() && list.getDegree() > (int)N)
+            return false;
+
+        StaticPolynomial result;
+        for (const BasicNode<T> *current = list.getHead(); current != nullptr; current = current->getNext())
+            result[current->getDegree()] = current->getCoefficient();
+        out = result;
+        return true;
+    }
+};
+
+#endif // STATICPOLYNOMIAL_H
@@ -0,0 +1,45 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "List.h"
+#include "OutputBuffer.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Distribution the coefficients of a synthetic polynomial are drawn from
+enum class CoefficientDistribution
+{
+    Uniform,       // Uniform in [-1000, 1000] (rounded for the integer types), the default
+    SmallIntegers, // Integers in [-9, 9]
+    Normal         // Normal with mean 0 and standard deviation 100 (rounded for the integer types)
+};
+
+// Shape of the synthetic polynomials of a workload
+struct WorkloadSpec
+{
+    // Degree of every polynomial; its leading term is always present
+    int degree = 1000;
+    // Probability that each lower degree has a term (1 gives a dense polynomial)
+    double density = 1.0;
+    CoefficientDistribution distribution = CoefficientDistribution::Uniform;
+    uint64_t seed = 1;
+};
+
+// Draws a polynomial with the degree, density and coefficient distribution of the spec; zero is never drawn
+template <typename T>
+BasicList<T> generatePolynomial(const WorkloadSpec &spec, std::mt19937_64 &random);
+
+// Draws evaluation points in [-1, 1] (-1, 0 or 1 for the integer types, so values do not overflow)
+template <typename T>
+std::vector<T> generatePoints(std::size_t count, std::mt19937_64 &random);
+
+// Writes a command file of `blocks` blocks that cycles through every command, with polynomials of the spec
+template <typename T>
+void writeWorkload(OutputBuffer &out, const WorkloadSpec &spec, int blocks);
+
+// Parses the name of a coefficient distribution ("uniform", "integers" or "normal")
+bool parseCoefficientDistribution(const std::string &name, CoefficientDistribution &distribution);
+
+#endif // WORKLOAD_H
@@ -1,16 +1,147 @@
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <thread>
 #include "include/FileProcessor.h"
+#include "include/Instrumentation.h"
+#include "include/ResultCache.h"
+#include "include/Server.h"
+#include "include/Multiplication.h"
+
+/**
+ * @brief Parses the argument of `-j` or `-p`: a positive number of threads, or 0 for one per hardware thread.
+ */
+static bool parseThreads(const std::string &text, int &threads)
+{
+    try
+    {
+        size_t used = 0;
+        int value = std::stoi(text, &used);
+        if (used != text.size() || value < 0)
+            return false;
+        threads = value > 0 ? value : (int)std::max(1u, std::thread::hardware_concurrency());
+        return true;
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+}
 
 int main(int argc, char *argv[])
 {
-    if (argc < 2)
+    CoefficientType type = CoefficientType::Float;
+    int jobs = 1;
+    int argument = 1;
+    std::string convertPath;
+    std::string serveAddress;
+
+    while (argument < argc)
+    {
+        std::string option = argv[argument];
+        if (option == "--stats")
+        {
+            instrumentationSettings().stats = true;
+            argument++;
+            continue;
+        }
+
+        // The last argument is the file, unless it is an option without a value
+        if (argument + 1 >= argc)
+            break;
+
+        if (option == "--type")
+        {
+            if (!parseCoefficientType(argv[argument + 1], type))
+            {
+                std::cerr << "Erro: Tipo de coeficiente inválido '" << argv[argument + 1]
+                          << "' (use float, double, int64 ou mod)." << std::endl;
+                return 1;
+            }
+        }
+        else if (option == "--format")
+        {
+            if (!parseOutputFormat(argv[argument + 1], outputSettings().format))
+            {
+                std::cerr << "Erro: Formato de saída inválido '" << argv[argument + 1]
+                          << "' (use pretty, pairs ou binary)." << std::endl;
+                return 1;
+            }
+        }
+        else if (option == "--cache")
+        {
+            // A path keeps the cache between runs; "-" only caches within the run
+            cacheSettings().enabled = true;
+            if (std::string(argv[argument + 1]) != "-")
+                cacheSettings().path = argv[argument + 1];
+        }
+        else if (option == "--trace")
+        {
+            instrumentationSettings().tracePath = argv[argument + 1];
+        }
+        else if (option == "--convert")
+        {
+            convertPath = argv[argument + 1];
+        }
+        else if (option == "--serve")
+        {
+            // "-" serves the standard input; anything else is the path of a Unix socket
+            serveAddress = argv[argument + 1];
+        }
+        else if (option == "-j")
+        {
+            if (!parseThreads(argv[argument + 1], multiplicationSettings().threads))
+            {
+                std::cerr << "Erro: Número de threads inválido '" << argv[argument + 1]
+                          << "' (use um inteiro positivo, ou 0 para todos os núcleos)." << std::endl;
+                return 1;
+            }
+        }
+        else if (option == "-p")
+        {
+            if (!parseThreads(argv[argument + 1], jobs))
+            {
+                std::cerr << "Erro: Número de comandos paralelos inválido '" << argv[argument + 1]
+                          << "' (use um inteiro positivo, ou 0 para todos os núcleos)." << std::endl;
+                return 1;
+            }
+        }
+        else
+        {
+            break;
+        }
+        argument += 2;
+    }
+
+    if ((argument >= argc) == serveAddress.empty())
     {
-        std::cerr << "Uso: " << argv[0] << " <caminho_para_o_arquivo>" << std::endl;
+        std::cerr << "Uso: " << argv[0] << " [--type float|double|int64|mod] [--format pretty|pairs|binary] [--convert saida] [--stats] [--trace saida.json] [--cache arquivo|-] [-j N] [-p N] <caminho_para_o_arquivo>" << std::endl;
+        std::cerr << "     " << argv[0] << " [--type float|double|int64|mod] [--format pretty|pairs|binary] [--stats] [--trace saida.json] [--cache arquivo|-] [-j N] --serve -|socket" << std::endl;
         return 1;
     }
 
-    std::string filePath = argv[1];
-    processFile(filePath);
+    if (!serveAddress.empty())
+    {
+        if (!startInstrumentation())
+            return 1;
+        bool served = serve(serveAddress, type);
+        finishInstrumentation();
+        finishResultCaches(instrumentationSettings().stats);
+        return served ? 0 : 1;
+    }
+
+    std::string filePath = argv[argument];
+    if (!convertPath.empty())
+    {
+        convertFile(filePath, convertPath, type);
+        return 0;
+    }
+
+    if (!startInstrumentation())
+        return 1;
+    processFile(filePath, type, jobs);
+    finishInstrumentation();
+    finishResultCaches(instrumentationSettings().stats);
 
     return 0;
 }
@@ -0,0 +1,254 @@
+#include "../include/BinaryFormat.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @class BinaryReader
+ * @brief Maps a file in the binary form into memory and hands out its sections in place.
+ *
+ * The file is mapped read-only with `mmap(2)`, so coefficients and degrees are read straight from
+ * the page cache without text parsing or copies into a read buffer; the kernel pages the file in
+ * (and out) as the reader moves through it, so memory use stays bounded however large it is.
+ */
+
+/**
+ * @brief Maps a file for reading.
+ *
+ * @param path The path to the file to be read.
+ *
+ * Use `isOpen` to check whether the file could be mapped; an empty file cannot.
+ */
+BinaryReader::BinaryReader(const std::string &path) : data(nullptr), length(0), offset(sizeof(BinaryHeader))
+{
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return;
+
+    struct stat status;
+    if (fstat(descriptor, &status) == 0 && status.st_size > 0)
+    {
+        void *mapping = mmap(nullptr, (std::size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping != MAP_FAILED)
+        {
+            data = static_cast<const char *>(mapping);
+            length = (std::size_t)status.st_size;
+#ifdef MADV_SEQUENTIAL
+            madvise(mapping, length, MADV_SEQUENTIAL);
+#endif
+        }
+    }
+    ::close(descriptor);
+}
+
+/**
+ * @brief Destructor that unmaps the file.
+ */
+BinaryReader::~BinaryReader()
+{
+    if (data != nullptr)
+        munmap(const_cast<char *>(data), length);
+}
+
+/**
+ * @brief Checks whether the file could be mapped.
+ */
+bool BinaryReader::isOpen() const
+{
+    return data != nullptr;
+}
+
+/**
+ * @brief Returns the header of the file.
+ *
+ * @return Pointer to the header, or nullptr if the file is too short or does not start with BINARY_MAGIC.
+ */
+const BinaryHeader *BinaryReader::header() const
+{
+    if (length < sizeof(BinaryHeader) || std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0)
+        return nullptr;
+    return reinterpret_cast<const BinaryHeader *>(data);
+}
+
+/**
+ * @brief Checks whether every record of the file has been read.
+ */
+bool BinaryReader::atEnd() const
+{
+    return offset >= length;
+}
+
+/**
+ * @brief Tells the processing loop that the whole file is available; output is then flushed in large blocks only.
+ */
+bool BinaryReader::hasBufferedInput() const
+{
+    return true;
+}
+
+/**
+ * @brief Checks whether a file starts with BINARY_MAGIC.
+ *
+ * @param path The path to the file; "-" (the standard input) is never binary.
+ * @return `true` if the file is a regular file that starts with the magic; otherwise, `false`.
+ *
+ * Only regular files are read: the bytes of a pipe, a FIFO or a terminal, such as `/dev/stdin` or
+ * `<(...)`, would be consumed by the check before the text reader opens the path again, and the
+ * binary reader needs a file it can map anyway.
+ */
+bool isBinaryFile(const std::string &path)
+{
+    if (path == "-")
+        return false;
+
+    struct stat status;
+    if (::stat(path.c_str(), &status) != 0 || !S_ISREG(status.st_mode))
+        return false;
+
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    char magic[sizeof(BINARY_MAGIC)];
+    bool binary = ::read(descriptor, magic, sizeof(magic)) == (ssize_t)sizeof(magic) &&
+                  std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+    ::close(descriptor);
+    return binary;
+}
+
+/**
+ * @brief Appends zero bytes up to the next multiple of BINARY_ALIGNMENT after a section of `bytes` bytes.
+ */
+static void pad(OutputBuffer &out, std::size_t bytes)
+{
+    static constexpr char ZEROS[BINARY_ALIGNMENT] = {};
+    std::size_t remainder = bytes % BINARY_ALIGNMENT;
+    if (remainder != 0)
+        out.write(ZEROS, BINARY_ALIGNMENT - remainder);
+}
+
+/**
+ * @brief Writes the header of a file in the binary form.
+ *
+ * @param out The buffer receiving the header.
+ * @param type The coefficient type of the values that follow.
+ * @param coefficientSize The size of a stored coefficient.
+ */
+void writeBinaryHeader(OutputBuffer &out, CoefficientType type, std::size_t coefficientSize)
+{
+    BinaryHeader header = {};
+    std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.type = (uint8_t)type;
+    header.coefficientSize = (uint8_t)coefficientSize;
+    header.byteOrder = BINARY_BYTE_ORDER;
+    out.write(&header, sizeof(header));
+}
+
+/**
+ * @brief Writes the record that starts a command.
+ *
+ * @param out The buffer receiving the record.
+ * @param command The command character.
+ * @param operandCount The number of operands written after it.
+ * @param line The line of the command in the text form, or 0.
+ */
+void writeBinaryCommand(OutputBuffer &out, char command, int operandCount, std::size_t line)
+{
+    BinaryCommand record = {};
+    record.command = command;
+    record.operandCount = (uint8_t)operandCount;
+    record.line = (uint32_t)line;
+    out.write(&record, sizeof(record));
+}
+
+/**
+ * @brief Writes the description of an operand.
+ */
+static void writeOperand(OutputBuffer &out, BinaryOperandKind kind, std::size_t count)
+{
+    BinaryOperand operand = {};
+    operand.kind = kind;
+    operand.count = (uint32_t)count;
+    out.write(&operand, sizeof(operand));
+}
+
+/**
+ * @brief Writes an integer result, such as a degree or a number of terms, as an Integer operand.
+ */
+void writeBinaryInteger(OutputBuffer &out, int64_t value)
+{
+    writeOperand(out, BinaryOperandKind::Integer, 1);
+    out.write(&value, sizeof(value));
+}
+
+/**
+ * @brief Writes a piece of text, such as an expression, as a Text operand.
+ */
+void writeBinaryText(OutputBuffer &out, std::string_view text)
+{
+    writeOperand(out, BinaryOperandKind::Text, text.size());
+    out.write(text.data(), text.size());
+    pad(out, text.size());
+}
+
+/**
+ * @brief Writes a polynomial as a Polynomial operand: its coefficients, then their degrees, in descending degree order.
+ *
+ * @param out The buffer receiving the operand.
+ * @param poly The polynomial to write; the zero polynomial has no terms.
+ */
+template <typename T>
+void writeBinaryPolynomial(OutputBuffer &out, const BasicList<T> &poly)
+{
+    using Stored = typename BinaryCoefficient<T>::Stored;
+
+    std::size_t count = (std::size_t)poly.size();
+    writeOperand(out, BinaryOperandKind::Polynomial, count);
+    for (const BasicNode<T> *current = poly.getHead(); current != nullptr; current = current->getNext())
+    {
+        Stored coefficient = BinaryCoefficient<T>::store(current->getCoefficient());
+        out.write(&coefficient, sizeof(coefficient));
+    }
+    pad(out, count * sizeof(Stored));
+    for (const BasicNode<T> *current = poly.getHead(); current != nullptr; current = current->getNext())
+    {
+        int32_t degree = current->getDegree();
+        out.write(&degree, sizeof(degree));
+    }
+    pad(out, count * sizeof(int32_t));
+}
+
+/**
+ * @brief Writes values as a Points operand, or a single value as a Value operand.
+ *
+ * @param out The buffer receiving the operand.
+ * @param kind BinaryOperandKind::Points or BinaryOperandKind::Value.
+ * @param values The values to write.
+ * @param count The number of values (1 for a Value operand).
+ */
+template <typename T>
+void writeBinaryValues(OutputBuffer &out, BinaryOperandKind kind, const T *values, std::size_t count)
+{
+    using Stored = typename BinaryCoefficient<T>::Stored;
+
+    writeOperand(out, kind, count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        Stored value = BinaryCoefficient<T>::store(values[i]);
+        out.write(&value, sizeof(value));
+    }
+    pad(out, count * sizeof(Stored));
+}
+
+template void writeBinaryPolynomial(OutputBuffer &out, const BasicList<float> &poly);
+template void writeBinaryPolynomial(OutputBuffer &out, const BasicList<double> &poly);
+template void writeBinaryPolynomial(OutputBuffer &out, const BasicList<int64_t> &poly);
+template void writeBinaryPolynomial(OutputBuffer &out, const BasicList<ModInt> &poly);
+
+template void writeBinaryValues(OutputBuffer &out, BinaryOperandKind kind, const float *values, std::size_t count);
+template void writeBinaryValues(OutputBuffer &out, BinaryOperandKind kind, const double *values, std::size_t count);
+template void writeBinaryValues(OutputBuffer &out, BinaryOperandKind kind, const int64_t *values, std::size_t count);
+template void writeBinaryValues(OutputBuffer &out, BinaryOperandKind kind, const ModInt *values, std::size_t count);
@@ -0,0 +1,32 @@
+#include "../include/Coefficient.h"
+
+/**
+ * @brief Formats a floating-point number with appropriate precision.
+ *
+ * @param first Start of the output range, with room for `MAX_NUMBER_LENGTH` characters.
+ * @param last End of the output range.
+ * @param value The number to format.
+ * @return The end of the written text.
+ *
+ * If the number is an integer, it is written without decimal places.
+ * Otherwise, it is written with two decimal places. `std::to_chars` rounds exactly as `printf`
+ * does, without any locale or stream state.
+ */
+template <typename T>
+static char *formatFloating(char *first, char *last, T value)
+{
+    if (value == T(0))
+        value = T(0); // Prints -0 as 0, like the integer conversion it replaces
+    int decimals = std::floor(value) == value ? 0 : 2;
+    return std::to_chars(first, last, value, std::chars_format::fixed, decimals).ptr;
+}
+
+char *CoefficientTraits<float>::formatTo(char *first, char *last, float value)
+{
+    return formatFloating(first, last, value);
+}
+
+char *CoefficientTraits<double>::formatTo(char *first, char *last, double value)
+{
+    return formatFloating(first, last, value);
+}
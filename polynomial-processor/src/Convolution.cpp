@@ -0,0 +1,502 @@
+#include "../include/Convolution.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+const uint32_t NTT_PRIMES[3] = {998244353u, 167772161u, 469762049u};
+
+/**
+ * @brief Returns the smallest power of two that is greater than or equal to `n`.
+ */
+static int nextPowerOfTwo(int n)
+{
+    int size = 1;
+    while (size < n)
+        size <<= 1;
+    return size;
+}
+
+/**
+ * @brief Reorders an array into bit-reversed index order, as needed by the iterative transforms.
+ */
+template <typename T>
+static void bitReverse(std::vector<T> &a)
+{
+    int n = (int)a.size();
+    for (int i = 1, j = 0; i < n; i++)
+    {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(a[i], a[j]);
+    }
+}
+
+/**
+ * @brief In-place iterative radix-2 complex FFT.
+ *
+ * @param a The array to transform; its size must be a power of two.
+ * @param invert If `true`, computes the inverse transform (including the 1/n scaling).
+ *
+ * The twiddle factors are taken from one table computed with cos/sin for every entry, which
+ * keeps the rounding error at O(log n) ulps instead of accumulating it through repeated products.
+ */
+static void fft(std::vector<std::complex<double>> &a, bool invert)
+{
+    int n = (int)a.size();
+    bitReverse(a);
+
+    const double pi = std::acos(-1.0);
+    std::vector<std::complex<double>> roots(n / 2);
+    for (int k = 0; k < n / 2; k++)
+    {
+        double angle = 2 * pi * k / n * (invert ? -1 : 1);
+        roots[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+
+    for (int len = 2; len <= n; len <<= 1)
+    {
+        int half = len / 2;
+        int step = n / len;
+        for (int i = 0; i < n; i += len)
+        {
+            for (int j = 0; j < half; j++)
+            {
+                std::complex<double> u = a[i + j];
+                std::complex<double> v = a[i + j + half] * roots[j * step];
+                a[i + j] = u + v;
+                a[i + j + half] = u - v;
+            }
+        }
+    }
+
+    if (invert)
+    {
+        for (std::complex<double> &value : a)
+            value /= n;
+    }
+}
+
+/**
+ * @brief Multiplies two real coefficient arrays with a floating-point FFT.
+ *
+ * @param a Coefficients of the first operand, indexed by degree.
+ * @param n Number of coefficients in `a`.
+ * @param b Coefficients of the second operand, indexed by degree.
+ * @param m Number of coefficients in `b`.
+ * @param out Buffer of `n + m - 1` coefficients receiving the product (overwritten).
+ *
+ * Both real operands are packed into one complex array (a in the real part, b in the imaginary
+ * part), so the product takes two transforms instead of three. Results whose magnitude is below
+ * the expected rounding error of the transform are flushed to zero, so cancelled terms do not
+ * reappear as noise.
+ */
+void fftMultiply(const double *a, int n, const double *b, int m, double *out)
+{
+    int size = nextPowerOfTwo(n + m - 1);
+    std::vector<std::complex<double>> packed(size);
+    double normA = 0.0, normB = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        packed[i].real(a[i]);
+        normA += a[i] * a[i];
+    }
+    for (int i = 0; i < m; i++)
+    {
+        packed[i].imag(b[i]);
+        normB += b[i] * b[i];
+    }
+
+    fft(packed, false);
+
+    // Unpack A(k) and B(k) from the combined spectrum and multiply them
+    std::vector<std::complex<double>> product(size);
+    for (int k = 0; k < size; k++)
+    {
+        std::complex<double> x = packed[k];
+        std::complex<double> y = std::conj(packed[(size - k) & (size - 1)]);
+        std::complex<double> spectrumA = (x + y) * 0.5;
+        std::complex<double> spectrumB = (x - y) * std::complex<double>(0.0, -0.5);
+        product[k] = spectrumA * spectrumB;
+    }
+
+    fft(product, true);
+
+    double noise = 8.0 * std::numeric_limits<double>::epsilon() * std::log2((double)size + 1.0) *
+                   std::sqrt(normA) * std::sqrt(normB);
+    for (int i = 0; i < n + m - 1; i++)
+    {
+        double value = product[i].real();
+        out[i] = std::abs(value) <= noise ? 0.0 : value;
+    }
+}
+
+/**
+ * @brief Squares a real coefficient array with a floating-point FFT of half the length of the square.
+ *
+ * @param a Coefficients of the operand, indexed by degree.
+ * @param n Number of coefficients in `a`.
+ * @param out Buffer of `2n - 1` coefficients receiving the square (overwritten).
+ *
+ * The real operand of length N (the transform length) goes through a complex transform of length
+ * N / 2, with its even coefficients in the real part and its odd ones in the imaginary part. The
+ * halves of the spectrum are split into the spectra E of the even and O of the odd coefficients,
+ * recombined as A(k) = E(k) + w^k O(k) and A(k + N/2) = E(k) - w^k O(k), squared, and packed back
+ * the same way for the inverse transform. The square thus takes two half-length transforms where
+ * `fftMultiply` takes two full-length ones. Noise is flushed to zero as in `fftMultiply`.
+ */
+void fftSquare(const double *a, int n, double *out)
+{
+    int size = nextPowerOfTwo(2 * n - 1);
+    if (size < 2)
+    {
+        out[0] = a[0] * a[0];
+        return;
+    }
+
+    int half = size / 2;
+    std::vector<std::complex<double>> packed(half);
+    double norm = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        if (i % 2 == 0)
+            packed[i / 2].real(a[i]);
+        else
+            packed[i / 2].imag(a[i]);
+        norm += a[i] * a[i];
+    }
+
+    fft(packed, false);
+
+    const double pi = std::acos(-1.0);
+    std::vector<std::complex<double>> product(half);
+    for (int k = 0; k < half; k++)
+    {
+        std::complex<double> x = packed[k];
+        std::complex<double> y = std::conj(packed[(half - k) & (half - 1)]);
+        std::complex<double> even = (x + y) * 0.5;
+        std::complex<double> odd = (x - y) * std::complex<double>(0.0, -0.5);
+        std::complex<double> twiddle = std::polar(1.0, 2 * pi * k / size);
+
+        std::complex<double> low = even + twiddle * odd;
+        std::complex<double> high = even - twiddle * odd;
+        low *= low;
+        high *= high;
+
+        // Spectra of the even and the odd coefficients of the square, packed as the operand was
+        std::complex<double> squareEven = (low + high) * 0.5;
+        std::complex<double> squareOdd = (low - high) * 0.5 * std::conj(twiddle);
+        product[k] = squareEven + std::complex<double>(0.0, 1.0) * squareOdd;
+    }
+
+    fft(product, true);
+
+    double noise = 8.0 * std::numeric_limits<double>::epsilon() * std::log2((double)size + 1.0) * norm;
+    for (int i = 0; i < 2 * n - 1; i++)
+    {
+        double value = i % 2 == 0 ? product[i / 2].real() : product[i / 2].imag();
+        out[i] = std::abs(value) <= noise ? 0.0 : value;
+    }
+}
+
+/**
+ * @brief Computes base^exponent modulo MOD by repeated squaring.
+ */
+template <uint32_t MOD>
+static uint32_t powMod(uint64_t base, uint64_t exponent)
+{
+    uint64_t result = 1;
+    base %= MOD;
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+            result = result * base % MOD;
+        base = base * base % MOD;
+        exponent >>= 1;
+    }
+    return (uint32_t)result;
+}
+
+/**
+ * @brief In-place iterative number-theoretic transform modulo MOD.
+ *
+ * @param a The array to transform; its size must be a power of two dividing MOD - 1.
+ * @param invert If `true`, computes the inverse transform (including the 1/n scaling).
+ *
+ * MOD is a template parameter so every reduction is a multiplication by a constant instead of a division.
+ */
+template <uint32_t MOD>
+static void ntt(std::vector<uint32_t> &a, bool invert)
+{
+    int n = (int)a.size();
+    bitReverse(a);
+
+    std::vector<uint32_t> roots(n / 2 > 0 ? n / 2 : 1);
+    for (int len = 2; len <= n; len <<= 1)
+    {
+        int half = len / 2;
+        uint32_t root = powMod<MOD>(3, (MOD - 1) / len);
+        if (invert)
+            root = powMod<MOD>(root, MOD - 2);
+
+        roots[0] = 1;
+        for (int j = 1; j < half; j++)
+            roots[j] = (uint32_t)((uint64_t)roots[j - 1] * root % MOD);
+
+        for (int i = 0; i < n; i += len)
+        {
+            for (int j = 0; j < half; j++)
+            {
+                uint32_t u = a[i + j];
+                uint32_t v = (uint32_t)((uint64_t)a[i + j + half] * roots[j] % MOD);
+                a[i + j] = u + v >= MOD ? u + v - MOD : u + v;
+                a[i + j + half] = u >= v ? u - v : u + MOD - v;
+            }
+        }
+    }
+
+    if (invert)
+    {
+        uint64_t inverse = powMod<MOD>(n, MOD - 2);
+        for (uint32_t &value : a)
+            value = (uint32_t)(value * inverse % MOD);
+    }
+}
+
+/**
+ * @brief Cyclic-free product of two residue arrays modulo MOD.
+ *
+ * A square (the same array passed as both operands) is transformed once, so it takes two transforms instead of three.
+ */
+template <uint32_t MOD>
+static void nttConvolve(const uint32_t *a, int n, const uint32_t *b, int m, uint32_t *out)
+{
+    int size = nextPowerOfTwo(n + m - 1);
+    std::vector<uint32_t> x(a, a + n);
+    x.resize(size, 0);
+    ntt<MOD>(x, false);
+
+    if (a == b && n == m)
+    {
+        for (int i = 0; i < size; i++)
+            x[i] = (uint32_t)((uint64_t)x[i] * x[i] % MOD);
+    }
+    else
+    {
+        std::vector<uint32_t> y(b, b + m);
+        y.resize(size, 0);
+        ntt<MOD>(y, false);
+        for (int i = 0; i < size; i++)
+            x[i] = (uint32_t)((uint64_t)x[i] * y[i] % MOD);
+    }
+    ntt<MOD>(x, true);
+
+    std::copy(x.begin(), x.begin() + n + m - 1, out);
+}
+
+/**
+ * @brief Multiplies two arrays of residues modulo one of the NTT primes.
+ *
+ * @param a Residues of the first operand, indexed by degree.
+ * @param n Number of residues in `a`.
+ * @param b Residues of the second operand, indexed by degree.
+ * @param m Number of residues in `b`.
+ * @param out Buffer of `n + m - 1` residues receiving the product (overwritten on success).
+ * @param modulus One of `NTT_PRIMES`.
+ * @return `false`, leaving `out` untouched, if the transform would be longer than `NTT_MAX_LENGTH`,
+ *         where the roots of unity of the smallest prime run out, or if `modulus` is not an NTT prime;
+ *         otherwise, `true`.
+ */
+bool nttMultiplyModulo(const uint32_t *a, int n, const uint32_t *b, int m, uint32_t *out, uint32_t modulus)
+{
+    if (nextPowerOfTwo(n + m - 1) > NTT_MAX_LENGTH)
+        return false;
+
+    if (modulus == NTT_PRIMES[0])
+        nttConvolve<998244353u>(a, n, b, m, out);
+    else if (modulus == NTT_PRIMES[1])
+        nttConvolve<167772161u>(a, n, b, m, out);
+    else if (modulus == NTT_PRIMES[2])
+        nttConvolve<469762049u>(a, n, b, m, out);
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Returns the modular inverse of `value` modulo the prime `modulus`.
+ */
+static uint64_t inverseMod(uint64_t value, uint64_t modulus)
+{
+    uint64_t result = 1, exponent = modulus - 2;
+    value %= modulus;
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+            result = result * value % modulus;
+        value = value * value % modulus;
+        exponent >>= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Multiplies two integer coefficient arrays exactly, through NTT and CRT.
+ *
+ * @param a Coefficients of the first operand, indexed by degree.
+ * @param n Number of coefficients in `a`.
+ * @param b Coefficients of the second operand, indexed by degree.
+ * @param m Number of coefficients in `b`.
+ * @param out Buffer of `n + m - 1` coefficients receiving the product (overwritten on success).
+ * @return `true` on success; `false` if a coefficient of the product could reach 2^63, where it
+ *         would not fit in an int64_t, or the transform would be longer than 2^23.
+ *
+ * Uses as many primes as needed to cover the bound max|a| * max|b| * min(n, m) and rebuilds each
+ * signed coefficient with Garner's algorithm. The bound is checked against 2^63 first: the three
+ * primes cover about 2^89, so a CRT value past the int64_t range would otherwise be truncated.
+ */
+bool nttMultiply(const int64_t *a, int n, const int64_t *b, int m, int64_t *out)
+{
+    long double maxA = 0.0L, maxB = 0.0L;
+    for (int i = 0; i < n; i++)
+        maxA = std::max(maxA, std::fabs((long double)a[i]));
+    for (int i = 0; i < m; i++)
+        maxB = std::max(maxB, std::fabs((long double)b[i]));
+
+    if (nextPowerOfTwo(n + m - 1) > NTT_MAX_LENGTH)
+        return false;
+
+    // The largest possible coefficient must fit in an int64_t
+    long double largest = maxA * maxB * std::min(n, m);
+    if (largest >= 9223372036854775808.0L) // 2^63
+        return false;
+
+    // Number of primes whose product exceeds twice the largest possible coefficient
+    long double bound = 2.0L * largest + 1.0L;
+    int primes = 0;
+    long double range = 1.0L;
+    while (primes < 3 && range <= bound)
+        range *= NTT_PRIMES[primes++];
+    if (range <= bound)
+        return false;
+
+    // A square passes the same residues twice, so nttConvolve transforms them once
+    bool square = a == b && n == m;
+    int length = n + m - 1;
+    std::vector<std::vector<uint32_t>> residues(primes, std::vector<uint32_t>(length));
+    std::vector<uint32_t> x(n), y(square ? 0 : m);
+    for (int p = 0; p < primes; p++)
+    {
+        int64_t modulus = NTT_PRIMES[p];
+        for (int i = 0; i < n; i++)
+            x[i] = (uint32_t)((a[i] % modulus + modulus) % modulus);
+        for (int i = 0; i < (int)y.size(); i++)
+            y[i] = (uint32_t)((b[i] % modulus + modulus) % modulus);
+        nttMultiplyModulo(x.data(), n, square ? x.data() : y.data(), m, residues[p].data(), NTT_PRIMES[p]);
+    }
+
+    // Garner's algorithm: value = v0 + p0 * v1 + p0 * p1 * v2, then mapped to the symmetric range
+    const uint64_t p0 = NTT_PRIMES[0], p1 = NTT_PRIMES[1], p2 = NTT_PRIMES[2];
+    const uint64_t inv01 = inverseMod(p0, p1);
+    const uint64_t inv012 = inverseMod(p0 * p1 % p2, p2);
+    __int128 product = 1;
+    for (int p = 0; p < primes; p++)
+        product *= NTT_PRIMES[p];
+
+    for (int i = 0; i < length; i++)
+    {
+        uint64_t v0 = residues[0][i];
+        __int128 value = v0;
+        if (primes > 1)
+        {
+            uint64_t v1 = (residues[1][i] + p1 - v0 % p1) % p1 * inv01 % p1;
+            value += (__int128)p0 * v1;
+            if (primes > 2)
+            {
+                uint64_t partial = (v0 + p0 % p2 * v1) % p2;
+                uint64_t v2 = (residues[2][i] + p2 - partial) % p2 * inv012 % p2;
+                value += (__int128)p0 * p1 * v2;
+            }
+        }
+        if (value > product / 2)
+            value -= product;
+        out[i] = (int64_t)value;
+    }
+    return true;
+}
+
+/**
+ * @brief Multiplies two integer-valued coefficient arrays exactly, through NTT and CRT.
+ *
+ * @param a Coefficients of the first operand, indexed by degree.
+ * @param n Number of coefficients in `a`.
+ * @param b Coefficients of the second operand, indexed by degree.
+ * @param m Number of coefficients in `b`.
+ * @param out Buffer of `n + m - 1` coefficients receiving the product (overwritten on success).
+ * @return `true` on success; `false` if a coefficient is not an integer below 2^53 or the integer
+ *         overload above fails, as it does when a coefficient of the product could reach 2^63
+ *         (`convolutionMultiply` then falls back to the FFT).
+ */
+bool nttMultiply(const double *a, int n, const double *b, int m, double *out)
+{
+    const double limit = 9007199254740992.0; // 2^53
+    bool square = a == b && n == m;
+    std::vector<int64_t> x(n), y(square ? 0 : m), product(n + m - 1);
+    for (int i = 0; i < n; i++)
+    {
+        if (a[i] != std::floor(a[i]) || std::abs(a[i]) >= limit)
+            return false;
+        x[i] = (int64_t)a[i];
+    }
+    for (int i = 0; i < (int)y.size(); i++)
+    {
+        if (b[i] != std::floor(b[i]) || std::abs(b[i]) >= limit)
+            return false;
+        y[i] = (int64_t)b[i];
+    }
+
+    if (!nttMultiply(x.data(), n, square ? x.data() : y.data(), m, product.data()))
+        return false;
+
+    for (int i = 0; i < n + m - 1; i++)
+        out[i] = (double)product[i];
+    return true;
+}
+
+/**
+ * @brief Multiplies two coefficient arrays through the transform selected by `mode`.
+ *
+ * @param a Coefficients of the first operand, indexed by degree.
+ * @param n Number of coefficients in `a`.
+ * @param b Coefficients of the second operand, indexed by degree.
+ * @param m Number of coefficients in `b`.
+ * @param out Buffer of `n + m - 1` coefficients receiving the product (overwritten).
+ * @param mode The transform to use. `Ntt` tries the exact NTT first and falls back to FFT.
+ */
+void convolutionMultiply(const double *a, int n, const double *b, int m, double *out, ConvolutionMode mode)
+{
+    if (mode != ConvolutionMode::Fft && nttMultiply(a, n, b, m, out))
+        return;
+
+    fftMultiply(a, n, b, m, out);
+}
+
+/**
+ * @brief Squares a coefficient array through the transform selected by `mode`.
+ *
+ * @param a Coefficients of the operand, indexed by degree.
+ * @param n Number of coefficients in `a`.
+ * @param out Buffer of `2n - 1` coefficients receiving the square (overwritten).
+ * @param mode The transform to use. `Ntt` tries the exact NTT first and falls back to FFT.
+ */
+void convolutionSquare(const double *a, int n, double *out, ConvolutionMode mode)
+{
+    if (mode != ConvolutionMode::Fft && nttMultiply(a, n, a, n, out))
+        return;
+
+    fftSquare(a, n, out);
+}
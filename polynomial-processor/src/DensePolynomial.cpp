@@ -0,0 +1,524 @@
+#include "../include/DensePolynomial.h"
+#include "../include/List.h"
+#include "../include/Multiplication.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @class BasicDensePolynomial
+ * @brief Represents a polynomial as a contiguous array of coefficients indexed by degree.
+ *
+ * Meant for polynomials that are (almost) fully dense up to their degree. The coefficients live in
+ * a single 64-byte aligned buffer padded to whole blocks of `BLOCK` coefficients, and the padding is kept
+ * at zero, so the arithmetic kernels can always run over whole blocks. The fixed-size inner loops
+ * are vectorized by the compiler (SSE/AVX, depending on the target flags).
+ */
+
+/**
+ * @brief Returns the number of blocks needed to hold `length` coefficients.
+ */
+template <typename T>
+int BasicDensePolynomial<T>::blocksFor(int length)
+{
+    return (length + BLOCK - 1) / BLOCK;
+}
+
+/**
+ * @brief Vectorized kernel that computes dst[i] += src[i] (or dst[i] -= src[i]) over whole blocks.
+ *
+ * Adding or subtracting directly, rather than multiplying by a sign, keeps the modular kernel down
+ * to one addition and one conditional subtraction per coefficient.
+ */
+template <typename T>
+static void accumulateBlocks(T *__restrict dst, const T *__restrict src, int blocks, bool subtract)
+{
+    constexpr int BLOCK = BasicDensePolynomial<T>::BLOCK;
+    dst = static_cast<T *>(__builtin_assume_aligned(dst, BasicDensePolynomial<T>::ALIGNMENT));
+    src = static_cast<const T *>(__builtin_assume_aligned(src, BasicDensePolynomial<T>::ALIGNMENT));
+
+    if (subtract)
+    {
+        for (int b = 0; b < blocks; b++)
+        {
+            for (int i = 0; i < BLOCK; i++)
+            {
+                dst[b * BLOCK + i] -= src[b * BLOCK + i];
+            }
+        }
+        return;
+    }
+
+    for (int b = 0; b < blocks; b++)
+    {
+        for (int i = 0; i < BLOCK; i++)
+        {
+            dst[b * BLOCK + i] += src[b * BLOCK + i];
+        }
+    }
+}
+
+/**
+ * @brief Vectorized kernel that computes dst[i] *= scalar over whole blocks.
+ */
+template <typename T>
+static void scaleBlocks(T *__restrict dst, int blocks, T scalar)
+{
+    constexpr int BLOCK = BasicDensePolynomial<T>::BLOCK;
+    dst = static_cast<T *>(__builtin_assume_aligned(dst, BasicDensePolynomial<T>::ALIGNMENT));
+
+    for (int b = 0; b < blocks; b++)
+    {
+        for (int i = 0; i < BLOCK; i++)
+        {
+            dst[b * BLOCK + i] *= scalar;
+        }
+    }
+}
+
+/**
+ * @brief Default constructor that initializes an empty (zero) polynomial.
+ */
+template <typename T>
+BasicDensePolynomial<T>::BasicDensePolynomial()
+    : coefficients(nullptr), length(0), capacity(0) {}
+
+/**
+ * @brief Builds a dense polynomial from a linked list polynomial.
+ *
+ * @param list The List object to convert.
+ *
+ * Copies the list's coefficient array when it already uses dense storage; otherwise allocates
+ * `list.getDegree() + 1` coefficients and scatters every term into its slot.
+ */
+template <typename T>
+BasicDensePolynomial<T>::BasicDensePolynomial(const BasicList<T> &list)
+    : coefficients(nullptr), length(0), capacity(0)
+{
+    if (list.isDenseStorage())
+    {
+        *this = list.getDenseStorage();
+        return;
+    }
+
+    if (list.isEmpty())
+        return;
+
+    allocate(list.getDegree() + 1);
+    for (const BasicNode<T> *current = list.getHead(); current != nullptr; current = current->getNext())
+    {
+        coefficients[current->getDegree()] = current->getCoefficient();
+    }
+    length = list.getDegree() + 1;
+}
+
+/**
+ * @brief Copy constructor that creates a deep copy of another DensePolynomial.
+ *
+ * @param other The DensePolynomial object to copy from.
+ */
+template <typename T>
+BasicDensePolynomial<T>::BasicDensePolynomial(const BasicDensePolynomial &other)
+    : coefficients(nullptr), length(0), capacity(0)
+{
+    if (other.length == 0)
+        return;
+
+    allocate(other.length);
+    std::memcpy(coefficients, other.coefficients, blocksFor(other.length) * BLOCK * sizeof(T));
+    length = other.length;
+}
+
+/**
+ * @brief Move constructor that takes over the coefficient buffer of another DensePolynomial.
+ *
+ * @param other The DensePolynomial object to move from; it is left as the zero polynomial.
+ */
+template <typename T>
+BasicDensePolynomial<T>::BasicDensePolynomial(BasicDensePolynomial &&other) noexcept
+    : coefficients(other.coefficients), length(other.length), capacity(other.capacity)
+{
+    other.coefficients = nullptr;
+    other.length = 0;
+    other.capacity = 0;
+}
+
+/**
+ * @brief Destructor that releases the coefficient buffer.
+ */
+template <typename T>
+BasicDensePolynomial<T>::~BasicDensePolynomial()
+{
+    release();
+}
+
+/**
+ * @brief Copy assignment operator that assigns one DensePolynomial to another.
+ *
+ * @param other The DensePolynomial object to assign from.
+ * @return Reference to the assigned DensePolynomial object.
+ */
+template <typename T>
+BasicDensePolynomial<T> &BasicDensePolynomial<T>::operator=(const BasicDensePolynomial &other)
+{
+    if (this == &other)
+        return *this;
+
+    BasicDensePolynomial copy(other);
+    std::swap(coefficients, copy.coefficients);
+    std::swap(length, copy.length);
+    std::swap(capacity, copy.capacity);
+    return *this;
+}
+
+/**
+ * @brief Move assignment operator that takes over the coefficient buffer of another DensePolynomial.
+ *
+ * @param other The DensePolynomial object to move from; it is left as the zero polynomial.
+ * @return Reference to the assigned DensePolynomial object.
+ */
+template <typename T>
+BasicDensePolynomial<T> &BasicDensePolynomial<T>::operator=(BasicDensePolynomial &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    release();
+    std::swap(coefficients, other.coefficients);
+    std::swap(length, other.length);
+    std::swap(capacity, other.capacity);
+    return *this;
+}
+
+/**
+ * @brief Retrieves the coefficient of a given degree.
+ *
+ * @param degree The degree of the term.
+ * @return The coefficient, or `0` if the degree is outside the stored range.
+ */
+template <typename T>
+T BasicDensePolynomial<T>::getCoefficient(int degree) const
+{
+    if (degree < 0 || degree >= length)
+        return T(0);
+    return coefficients[degree];
+}
+
+/**
+ * @brief Sets the coefficient of a given degree, growing the buffer if needed.
+ *
+ * @param degree The degree of the term (must be non-negative).
+ * @param coefficient The new coefficient.
+ */
+template <typename T>
+void BasicDensePolynomial<T>::setCoefficient(int degree, T coefficient)
+{
+    if (degree < 0)
+        return;
+
+    if (degree >= length)
+    {
+        if (coefficient == T(0))
+            return;
+        allocate(degree + 1);
+        length = degree + 1;
+    }
+
+    coefficients[degree] = coefficient;
+    if (coefficient == T(0) && degree == length - 1)
+        trim();
+}
+
+/**
+ * @brief Retrieves the highest degree of the polynomial.
+ *
+ * @return The highest degree with a non-zero coefficient, or `0` for the zero polynomial.
+ */
+template <typename T>
+int BasicDensePolynomial<T>::getDegree() const
+{
+    return length == 0 ? 0 : length - 1;
+}
+
+/**
+ * @brief Counts the non-zero terms of the polynomial.
+ *
+ * @return The number of non-zero coefficients.
+ */
+template <typename T>
+int BasicDensePolynomial<T>::size() const
+{
+    int count = 0;
+    for (int i = 0; i < length; i++)
+    {
+        count += coefficients[i] != T(0);
+    }
+    return count;
+}
+
+/**
+ * @brief Checks whether the polynomial is zero.
+ *
+ * @return `true` if no coefficient is stored; otherwise, `false`.
+ */
+template <typename T>
+bool BasicDensePolynomial<T>::isEmpty() const
+{
+    return length == 0;
+}
+
+/**
+ * @brief Resets the polynomial to zero while keeping the buffer for reuse.
+ */
+template <typename T>
+void BasicDensePolynomial<T>::clear()
+{
+    if (length > 0)
+        std::fill_n(coefficients, blocksFor(length) * BLOCK, T(0));
+    length = 0;
+}
+
+/**
+ * @brief Gives read access to the coefficient buffer, indexed by degree.
+ *
+ * @return Pointer to `getDegree() + 1` coefficients (or `nullptr` for the zero polynomial).
+ */
+template <typename T>
+const T *BasicDensePolynomial<T>::data() const
+{
+    return coefficients;
+}
+
+/**
+ * @brief Converts the polynomial back to a linked list representation.
+ *
+ * @return A List object with every non-zero coefficient; the list picks its own storage.
+ */
+template <typename T>
+BasicList<T> BasicDensePolynomial<T>::toList() const
+{
+    return BasicList<T>(*this);
+}
+
+/**
+ * @brief Overloads the addition operator to add two dense polynomials.
+ *
+ * @param other The DensePolynomial object to add.
+ * @return A new DensePolynomial object representing the sum.
+ */
+template <typename T>
+BasicDensePolynomial<T> BasicDensePolynomial<T>::operator+(const BasicDensePolynomial &other) const
+{
+    BasicDensePolynomial result(length >= other.length ? *this : other);
+    result.accumulate(length >= other.length ? other : *this, false);
+    return result;
+}
+
+/**
+ * @brief Overloads the subtraction operator to subtract one dense polynomial from another.
+ *
+ * @param other The DensePolynomial object to subtract.
+ * @return A new DensePolynomial object representing the difference.
+ */
+template <typename T>
+BasicDensePolynomial<T> BasicDensePolynomial<T>::operator-(const BasicDensePolynomial &other) const
+{
+    BasicDensePolynomial result;
+    result.allocate(length > other.length ? length : other.length);
+    if (length > 0)
+        std::memcpy(result.coefficients, coefficients, blocksFor(length) * BLOCK * sizeof(T));
+    result.length = length;
+    result.accumulate(other, true);
+    return result;
+}
+
+/**
+ * @brief Overloads the multiplication operator to multiply two dense polynomials.
+ *
+ * @param other The DensePolynomial object to multiply with.
+ * @return A new DensePolynomial object representing the product.
+ *
+ * Uses `multiplyCoefficients` (Karatsuba or FFT/NTT) in the accumulator type of the coefficients.
+ */
+template <typename T>
+BasicDensePolynomial<T> BasicDensePolynomial<T>::operator*(const BasicDensePolynomial &other) const
+{
+    BasicDensePolynomial result;
+    if (length == 0 || other.length == 0)
+        return result;
+
+    std::vector<Accumulator> x(coefficients, coefficients + length);
+    std::vector<Accumulator> y(other.coefficients, other.coefficients + other.length);
+    std::vector<Accumulator> product(length + other.length - 1);
+    multiplyCoefficients(x.data(), length, y.data(), other.length, product.data());
+
+    result.allocate((int)product.size());
+    for (size_t i = 0; i < product.size(); i++)
+    {
+        result.coefficients[i] = (T)product[i];
+    }
+    result.length = (int)product.size();
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Overloads the multiplication operator to scale the polynomial by a constant.
+ *
+ * @param scalar The factor applied to every coefficient.
+ * @return A new DensePolynomial object with the scaled coefficients.
+ */
+template <typename T>
+BasicDensePolynomial<T> BasicDensePolynomial<T>::operator*(T scalar) const
+{
+    BasicDensePolynomial result(*this);
+    result *= scalar;
+    return result;
+}
+
+/**
+ * @brief Adds another dense polynomial into the current one, in place.
+ *
+ * @param other The DensePolynomial object to add.
+ * @return Reference to the current DensePolynomial object.
+ */
+template <typename T>
+BasicDensePolynomial<T> &BasicDensePolynomial<T>::operator+=(const BasicDensePolynomial &other)
+{
+    accumulate(other, false);
+    return *this;
+}
+
+/**
+ * @brief Subtracts another dense polynomial from the current one, in place.
+ *
+ * @param other The DensePolynomial object to subtract.
+ * @return Reference to the current DensePolynomial object.
+ */
+template <typename T>
+BasicDensePolynomial<T> &BasicDensePolynomial<T>::operator-=(const BasicDensePolynomial &other)
+{
+    accumulate(other, true);
+    return *this;
+}
+
+/**
+ * @brief Scales the polynomial by a constant, in place.
+ *
+ * @param scalar The factor applied to every coefficient.
+ * @return Reference to the current DensePolynomial object.
+ */
+template <typename T>
+BasicDensePolynomial<T> &BasicDensePolynomial<T>::operator*=(T scalar)
+{
+    if (length == 0)
+        return *this;
+
+    if (scalar == T(0))
+    {
+        release();
+        return *this;
+    }
+
+    scaleBlocks(coefficients, blocksFor(length), scalar);
+    clearPadding();
+    trim();
+    return *this;
+}
+
+/**
+ * @brief Helper method that makes room for at least `minLength` coefficients.
+ *
+ * @param minLength The number of coefficients the buffer must hold.
+ *
+ * The capacity is rounded up to whole blocks. Existing coefficients are preserved and
+ * every new slot (including the padding) is zero.
+ */
+template <typename T>
+void BasicDensePolynomial<T>::allocate(int minLength)
+{
+    if (minLength <= capacity)
+        return;
+
+    int newCapacity = blocksFor(minLength) * BLOCK;
+    T *buffer = static_cast<T *>(::operator new(newCapacity * sizeof(T), std::align_val_t(ALIGNMENT)));
+    std::fill_n(buffer, newCapacity, T(0));
+    if (length > 0)
+        std::memcpy(buffer, coefficients, length * sizeof(T));
+
+    release();
+    coefficients = buffer;
+    capacity = newCapacity;
+}
+
+/**
+ * @brief Helper method that frees the coefficient buffer and resets the polynomial to zero.
+ */
+template <typename T>
+void BasicDensePolynomial<T>::release()
+{
+    if (coefficients != nullptr)
+        ::operator delete(coefficients, std::align_val_t(ALIGNMENT));
+    coefficients = nullptr;
+    length = 0;
+    capacity = 0;
+}
+
+/**
+ * @brief Helper method that drops leading zero coefficients so `length - 1` is the real degree.
+ */
+template <typename T>
+void BasicDensePolynomial<T>::trim()
+{
+    while (length > 0 && coefficients[length - 1] == T(0))
+    {
+        length--;
+    }
+}
+
+/**
+ * @brief Helper method that resets the slots after `length` in the last used block to zero.
+ *
+ * Needed after scaling, since an infinite or NaN factor would otherwise leave garbage in the padding.
+ */
+template <typename T>
+void BasicDensePolynomial<T>::clearPadding()
+{
+    int end = blocksFor(length) * BLOCK;
+    for (int i = length; i < end; i++)
+    {
+        coefficients[i] = T(0);
+    }
+}
+
+/**
+ * @brief Helper method that adds `other` into (or subtracts it from) the current polynomial.
+ *
+ * @param other The DensePolynomial object to accumulate.
+ * @param subtract If `true`, subtracts `other` instead of adding it.
+ */
+template <typename T>
+void BasicDensePolynomial<T>::accumulate(const BasicDensePolynomial &other, bool subtract)
+{
+    if (other.length == 0)
+        return;
+
+    if (this == &other)
+    {
+        *this *= subtract ? T(0) : T(2);
+        return;
+    }
+
+    allocate(other.length);
+    accumulateBlocks(coefficients, other.coefficients, blocksFor(other.length), subtract);
+    if (other.length > length)
+        length = other.length;
+    trim();
+}
+
+template class BasicDensePolynomial<float>;
+template class BasicDensePolynomial<double>;
+template class BasicDensePolynomial<int64_t>;
+template class BasicDensePolynomial<ModInt>;
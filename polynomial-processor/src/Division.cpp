@@ -0,0 +1,1099 @@
+#include "../include/Division.h"
+#include "../include/Multiplication.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <new>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <unistd.h>
+
+/**
+ * @brief Returns the settings shared by every division.
+ *
+ * @return Reference to the process-wide DivisionSettings object, which may be tuned at startup.
+ */
+DivisionSettings &divisionSettings()
+{
+    static DivisionSettings settings;
+    return settings;
+}
+
+/**
+ * @brief Returns the inverse of a coefficient; for int64_t only the units 1 and -1 have one, and are their own.
+ */
+static double reciprocal(double value)
+{
+    return 1.0 / value;
+}
+
+static int64_t reciprocal(int64_t value)
+{
+    return value;
+}
+
+static ModInt reciprocal(ModInt value)
+{
+    return value.inverse();
+}
+
+/**
+ * @brief Divides a coefficient by the leading coefficient of a divisor.
+ *
+ * @param inverse `reciprocal(denominator)`, computed once per division: ModInt multiplies by it
+ *                instead of inverting the denominator for every quotient coefficient, while double
+ *                still divides, so its quotients round as before.
+ * @return `false` if the quotient is not exact, which can only happen for int64_t.
+ */
+static bool divideExactly(double numerator, double denominator, double, double &quotient)
+{
+    quotient = numerator / denominator;
+    return true;
+}
+
+static bool divideExactly(int64_t numerator, int64_t denominator, int64_t, int64_t &quotient)
+{
+    quotient = numerator / denominator;
+    return quotient * denominator == numerator;
+}
+
+static bool divideExactly(ModInt numerator, ModInt, ModInt inverse, ModInt &quotient)
+{
+    quotient = numerator * inverse;
+    return true;
+}
+
+/**
+ * @brief Computes the truncated inverse of a power series by Newton iteration.
+ *
+ * @param f Coefficients of the series, indexed by degree; `f[0]` must be invertible.
+ * @param n Number of coefficients wanted.
+ * @return The first `n` coefficients of g such that f * g = 1 mod x^n.
+ *
+ * Doubles the number of correct coefficients at each step with g = g * (2 - f * g), so the total
+ * cost is a constant number of multiplications of size n. With `known` correct coefficients,
+ * f * g = 1 + x^known * e, so the step is g - x^known * (g * e) and only the `next - known`
+ * coefficients of e take part in the second product.
+ */
+template <typename A>
+std::vector<A> seriesInverse(const std::vector<A> &f, int n)
+{
+    std::vector<A> g(1, reciprocal(f[0]));
+    for (int known = 1; known < n;)
+    {
+        int next = std::min(2 * known, n);
+
+        std::vector<A> head(f.begin(), f.begin() + std::min<size_t>(next, f.size()));
+        std::vector<A> product = multiplyVectors(head, g);
+        product.resize(next, A(0));
+        std::vector<A> error(product.begin() + known, product.end());
+
+        std::vector<A> update = multiplyVectors(g, error);
+        g.resize(next, A(0));
+        for (int i = known; i < next; i++)
+            g[i] -= update[i - known];
+        known = next;
+    }
+    g.resize(n, A(0));
+    return g;
+}
+
+/**
+ * @brief Divides two coefficient vectors with the classical long division.
+ *
+ * @param a Coefficients of the dividend, indexed by degree.
+ * @param b Coefficients of the divisor, indexed by degree; the last one must be non-zero.
+ * @param quotient Receives the `a.size() - b.size() + 1` coefficients of the quotient (empty if deg a < deg b).
+ * @param remainder Receives the `b.size() - 1` low coefficients of the remainder.
+ * @return `false` if a coefficient of the quotient is not an integer (int64_t only); otherwise, `true`.
+ *
+ * Costs O((deg a - deg b + 1) * deg b).
+ */
+template <typename A>
+bool longDivide(const std::vector<A> &a, const std::vector<A> &b,
+                std::vector<A> &quotient, std::vector<A> &remainder)
+{
+    int n = (int)a.size();
+    int m = (int)b.size();
+
+    std::vector<A> rest(a);
+    quotient.assign(n >= m ? n - m + 1 : 0, A(0));
+    A inverse = reciprocal(b[m - 1]);
+    for (int i = n - m; i >= 0; i--)
+    {
+        A coeff;
+        if (!divideExactly(rest[i + m - 1], b[m - 1], inverse, coeff))
+            return false;
+        quotient[i] = coeff;
+        for (int j = 0; j < m; j++)
+        {
+            rest[i + j] -= coeff * b[j];
+        }
+    }
+
+    rest.resize(std::min(n, m - 1));
+    rest.resize(m - 1, A(0));
+    remainder.swap(rest);
+    return true;
+}
+
+/**
+ * @brief Computes the reciprocal of a reversed divisor, which divides any dividend by it.
+ *
+ * @param b Coefficients of the divisor, indexed by degree; the last one must be invertible.
+ * @param n Number of coefficients wanted: the longest quotient it will be used for.
+ * @return The first `n` coefficients of rev(b)^-1, where rev(b) has the coefficients of b in reverse order.
+ */
+template <typename A>
+std::vector<A> reversedInverse(const std::vector<A> &b, int n)
+{
+    std::vector<A> reversed(std::min<size_t>(n, b.size()));
+    for (int i = 0; i < (int)reversed.size(); i++)
+        reversed[i] = b[b.size() - 1 - i];
+    return seriesInverse(reversed, n);
+}
+
+/**
+ * @brief Divides two coefficient vectors through a Newton-iteration reciprocal.
+ *
+ * @param a Coefficients of the dividend, indexed by degree.
+ * @param b Coefficients of the divisor, indexed by degree; the last one must be non-zero.
+ * @param quotient Receives the `a.size() - b.size() + 1` coefficients of the quotient (empty if deg a < deg b).
+ * @param remainder Receives the `b.size() - 1` low coefficients of the remainder.
+ * @return `false` if the quotient does not have integer coefficients (int64_t only); otherwise, `true`.
+ *
+ * With k = deg a - deg b + 1, the reversed quotient is rev(a) * rev(b)^-1 mod x^k, and the remainder
+ * is a - b * q, so a division costs a few multiplications through the fast kernels. When k or deg b
+ * is below `newtonThreshold`, the classical long division is cheaper and is used instead.
+ * int64_t vectors always use the long division: the reciprocal only exists for a leading coefficient
+ * of 1 or -1, and its coefficients can outgrow int64_t even when the quotient does not.
+ */
+template <typename A>
+bool divideCoefficients(const std::vector<A> &a, const std::vector<A> &b,
+                        std::vector<A> &quotient, std::vector<A> &remainder)
+{
+    int n = (int)a.size();
+    int m = (int)b.size();
+    int k = n - m + 1;
+
+    if (std::is_same<A, int64_t>::value || k <= 0 || std::min(k, m) <= divisionSettings().newtonThreshold)
+        return longDivide(a, b, quotient, remainder);
+
+    return divideCoefficients(a, b, reversedInverse(b, k), quotient, remainder);
+}
+
+/**
+ * @brief Divides two coefficient vectors with a reciprocal of the divisor computed beforehand.
+ *
+ * @param a Coefficients of the dividend, indexed by degree.
+ * @param b Coefficients of the divisor, indexed by degree; the last one must be non-zero.
+ * @param inverse The reciprocal `reversedInverse(b, n)`; a quotient longer than `n` uses the long division.
+ * @param quotient Receives the `a.size() - b.size() + 1` coefficients of the quotient (empty if deg a < deg b).
+ * @param remainder Receives the `b.size() - 1` low coefficients of the remainder.
+ * @return `false` if the quotient does not have integer coefficients (int64_t only); otherwise, `true`.
+ *
+ * Works like the overload above, for many divisions by the same divisor, such as the reductions of
+ * a modular power: the Newton iteration runs once, and each division costs two multiplications.
+ */
+template <typename A>
+bool divideCoefficients(const std::vector<A> &a, const std::vector<A> &b, const std::vector<A> &inverse,
+                        std::vector<A> &quotient, std::vector<A> &remainder)
+{
+    int n = (int)a.size();
+    int m = (int)b.size();
+    int k = n - m + 1;
+
+    if (std::is_same<A, int64_t>::value || k <= 0 || std::min(k, m) <= divisionSettings().newtonThreshold ||
+        k > (int)inverse.size())
+        return longDivide(a, b, quotient, remainder);
+
+    std::vector<A> reversedA(k);
+    for (int i = 0; i < k; i++)
+        reversedA[i] = a[n - 1 - i];
+
+    std::vector<A> reversedQ = multiplyVectors(reversedA, std::vector<A>(inverse.begin(), inverse.begin() + k));
+    reversedQ.resize(k);
+    quotient.assign(reversedQ.rbegin(), reversedQ.rend());
+
+    std::vector<A> product = multiplyVectors(b, quotient);
+    remainder.assign(m - 1, A(0));
+    for (int i = 0; i < m - 1; i++)
+    {
+        remainder[i] = a[i] - product[i];
+    }
+    return true;
+}
+
+/**
+ * @brief Tells whether a remainder coefficient is zero, or within `zeroTolerance` of a magnitude.
+ *
+ * @param largest The largest magnitude among the coefficients of the dividend.
+ *
+ * Only floating-point coefficients carry rounding noise; the others must be exactly zero.
+ */
+template <typename A>
+static bool isNoise(A value, A largest)
+{
+    if constexpr (std::is_floating_point<A>::value)
+        return std::abs(value) <= divisionSettings().zeroTolerance * largest;
+    else
+        return value == A(0);
+}
+
+/**
+ * @brief Zeroes the remainder coefficients that are rounding noise (see `isNoise`).
+ */
+template <typename A>
+static void dropNoise(std::vector<A> &remainder, A largest)
+{
+    for (A &coefficient : remainder)
+        if (isNoise(coefficient, largest))
+            coefficient = A(0);
+}
+
+/**
+ * @brief Returns the largest magnitude among the coefficients of a vector (floating-point only; 0 otherwise).
+ */
+template <typename A>
+static A largestMagnitude(const std::vector<A> &p)
+{
+    A largest = A(0);
+    if constexpr (std::is_floating_point<A>::value)
+    {
+        for (A coefficient : p)
+            largest = std::max(largest, std::abs(coefficient));
+    }
+    return largest;
+}
+
+/**
+ * @brief Prepares the divisor of many reductions.
+ *
+ * @param m Coefficients of the divisor, indexed by degree; the last one must be non-zero.
+ *
+ * The squares and products of remainders have degree below 2 deg m, so their quotients have at
+ * most deg m - 1 coefficients, which is the length of the reciprocal computed here (none for
+ * int64_t, or when the long division is cheaper anyway).
+ */
+template <typename A>
+Modulus<A>::Modulus(std::vector<A> m) : divisor(std::move(m))
+{
+    int length = (int)divisor.size() - 2;
+    if (!std::is_same<A, int64_t>::value && length > divisionSettings().newtonThreshold)
+        inverse = reversedInverse(divisor, length);
+}
+
+/**
+ * @brief Replaces p with p mod m, without zero leading coefficients.
+ *
+ * @return `false` if the division is not exact (int64_t only); otherwise, `true`.
+ *
+ * A quotient longer than the shared reciprocal is divided with a reciprocal of its own. For
+ * floating-point coefficients, remainder coefficients within `zeroTolerance` of the largest
+ * coefficient of p are dropped, as `dividePolynomials` does.
+ */
+template <typename A>
+bool Modulus<A>::reduce(std::vector<A> &p) const
+{
+    int quotientLength = (int)p.size() - (int)divisor.size() + 1;
+    if (quotientLength > 0)
+    {
+        std::vector<A> quotient, remainder;
+        bool divided = quotientLength <= (int)inverse.size()
+                           ? divideCoefficients(p, divisor, inverse, quotient, remainder)
+                           : divideCoefficients(p, divisor, quotient, remainder);
+        if (!divided)
+            return false;
+
+        dropNoise(remainder, largestMagnitude(p));
+        p.swap(remainder);
+    }
+
+    while (!p.empty() && p.back() == A(0))
+        p.pop_back();
+    return true;
+}
+
+/**
+ * @brief Computes x^exponent mod m by repeated squaring.
+ *
+ * @param exponent The exponent, as large as the degree of any term.
+ * @param power Receives the remainder, trimmed.
+ * @return `false` if a reduction is not exact (int64_t only); otherwise, `true`.
+ *
+ * Reads the bits of the exponent from the most significant one down: every bit squares the running
+ * remainder, and every set bit then multiplies it by x, a shift; each step is reduced at once, so
+ * the cost is about log2(exponent) squares and divisions of size deg m, whatever the exponent.
+ */
+template <typename A>
+bool Modulus<A>::monomial(uint64_t exponent, std::vector<A> &power) const
+{
+    power.assign(1, A(1));
+    if (!reduce(power))
+        return false;
+
+    for (int bit = exponent ? 63 - __builtin_clzll(exponent) : -1; bit >= 0 && !power.empty(); bit--)
+    {
+        power = squareVectors(power);
+        if (!reduce(power))
+            return false;
+        if ((exponent >> bit) & 1)
+        {
+            power.insert(power.begin(), A(0));
+            if (!reduce(power))
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the degree of a trimmed coefficient vector, or -1 for the zero polynomial.
+ */
+template <typename A>
+static int degreeOf(const std::vector<A> &p)
+{
+    return (int)p.size() - 1;
+}
+
+/**
+ * @brief Drops the zero leading coefficients of a vector; for double, those at or below a tolerance.
+ */
+template <typename A>
+static void trimLeading(std::vector<A> &p, double)
+{
+    while (!p.empty() && p.back() == A(0))
+        p.pop_back();
+}
+
+static void trimLeading(std::vector<double> &p, double tolerance)
+{
+    while (!p.empty() && std::abs(p.back()) <= tolerance)
+        p.pop_back();
+}
+
+/**
+ * @brief Scales a non-zero vector over a field so that its leading coefficient is 1.
+ */
+template <typename A>
+static void makeMonic(std::vector<A> &p)
+{
+    if (p.empty())
+        return;
+    A inverse = reciprocal(p.back());
+    for (A &coefficient : p)
+        coefficient = coefficient * inverse;
+    p.back() = A(1);
+}
+
+/**
+ * @brief Returns the sum of two coefficient vectors, trimmed.
+ */
+template <typename A>
+static std::vector<A> addVectors(const std::vector<A> &x, const std::vector<A> &y)
+{
+    std::vector<A> sum(std::max(x.size(), y.size()), A(0));
+    for (size_t i = 0; i < x.size(); i++)
+        sum[i] += x[i];
+    for (size_t i = 0; i < y.size(); i++)
+        sum[i] += y[i];
+    trimLeading(sum, 0.0);
+    return sum;
+}
+
+/**
+ * @brief Returns p div x^count: the coefficients of p from degree `count` up.
+ */
+template <typename A>
+static std::vector<A> dropLow(const std::vector<A> &p, int count)
+{
+    if (count >= (int)p.size())
+        return std::vector<A>();
+    return std::vector<A>(p.begin() + count, p.end());
+}
+
+/**
+ * @brief Replaces (a, b) with (b, a mod b), the step of the Euclidean algorithm.
+ *
+ * @param quotient Receives a div b.
+ * @param tolerance Magnitude at or below which a leading coefficient of the remainder is dropped (double only).
+ */
+template <typename A>
+static void euclidStep(std::vector<A> &a, std::vector<A> &b, std::vector<A> &quotient, double tolerance)
+{
+    std::vector<A> remainder;
+    divideCoefficients(a, b, quotient, remainder);
+    trimLeading(remainder, tolerance);
+    a.swap(b);
+    b.swap(remainder);
+}
+
+/**
+ * @brief 2x2 matrix of polynomials, the product of the steps of the Euclidean algorithm it stands for.
+ *
+ * Every step (a, b) -> (b, a - q b) is the matrix [[0, 1], [1, -q]], whose determinant is -1, so any
+ * product of steps keeps the GCD of the pair it is applied to.
+ */
+template <typename A>
+struct GcdMatrix
+{
+    std::vector<A> entries[2][2];
+
+    static GcdMatrix identity()
+    {
+        GcdMatrix matrix;
+        matrix.entries[0][0].assign(1, A(1));
+        matrix.entries[1][1].assign(1, A(1));
+        return matrix;
+    }
+
+    // Multiplies the matrix on the left by the step of quotient q
+    void step(const std::vector<A> &q)
+    {
+        for (int column = 0; column < 2; column++)
+        {
+            std::vector<A> product = multiplyVectors(q, entries[1][column]);
+            for (A &coefficient : product)
+                coefficient = -coefficient;
+            std::vector<A> next = addVectors(entries[0][column], product);
+            entries[0][column].swap(entries[1][column]);
+            entries[1][column].swap(next);
+        }
+    }
+
+    // Returns (M00 a + M01 b, M10 a + M11 b)
+    void apply(const std::vector<A> &a, const std::vector<A> &b, std::vector<A> &c, std::vector<A> &d) const
+    {
+        c = addVectors(multiplyVectors(entries[0][0], a), multiplyVectors(entries[0][1], b));
+        d = addVectors(multiplyVectors(entries[1][0], a), multiplyVectors(entries[1][1], b));
+    }
+
+    // Returns this * other
+    GcdMatrix operator*(const GcdMatrix &other) const
+    {
+        GcdMatrix product;
+        for (int row = 0; row < 2; row++)
+            for (int column = 0; column < 2; column++)
+                product.entries[row][column] = addVectors(multiplyVectors(entries[row][0], other.entries[0][column]),
+                                                          multiplyVectors(entries[row][1], other.entries[1][column]));
+        return product;
+    }
+};
+
+/**
+ * @brief Computes the steps of the Euclidean algorithm that bring a pair halfway down in degree.
+ *
+ * @param a Coefficients of the first polynomial, trimmed.
+ * @param b Coefficients of the second polynomial, trimmed, with deg b < deg a.
+ * @return The product M of the steps such that (c, d) = M (a, b) has deg c >= m > deg d, with m = ceil(deg a / 2).
+ *
+ * The quotients of the first half of the remainder sequence only depend on the high halves of the
+ * operands, so they are found by a recursive call on a div x^m and b div x^m; one explicit step and a
+ * second recursive call on the high halves of the result complete the reduction. The total cost is
+ * O(M(n) log n) instead of the O(n^2) of the classical algorithm, which is used below `halfGcdThreshold`.
+ */
+template <typename A>
+static GcdMatrix<A> halfGcd(const std::vector<A> &a, const std::vector<A> &b)
+{
+    int m = (degreeOf(a) + 1) / 2;
+    GcdMatrix<A> result = GcdMatrix<A>::identity();
+    if (degreeOf(b) < m)
+        return result;
+
+    std::vector<A> c, d, quotient;
+    if (degreeOf(a) < divisionSettings().halfGcdThreshold)
+    {
+        c = a;
+        d = b;
+        while (degreeOf(d) >= m)
+        {
+            euclidStep(c, d, quotient, 0.0);
+            result.step(quotient);
+        }
+        return result;
+    }
+
+    result = halfGcd(dropLow(a, m), dropLow(b, m));
+    result.apply(a, b, c, d);
+    if (degreeOf(d) < m)
+        return result;
+
+    euclidStep(c, d, quotient, 0.0);
+    result.step(quotient);
+    if (degreeOf(d) < m)
+        return result;
+
+    int k = std::max(0, 2 * m - degreeOf(c));
+    return halfGcd(dropLow(c, k), dropLow(d, k)) * result;
+}
+
+/**
+ * @brief Returns the GCD of the absolute values of the coefficients of an integer vector.
+ */
+static int64_t contentOf(const std::vector<int64_t> &p)
+{
+    int64_t content = 0;
+    for (int64_t coefficient : p)
+        content = std::gcd(content, coefficient);
+    return content;
+}
+
+/**
+ * @brief Divides an integer vector by its content, leaving a primitive polynomial.
+ */
+static void makePrimitive(std::vector<int64_t> &p)
+{
+    int64_t content = contentOf(p);
+    if (content > 1)
+        for (int64_t &coefficient : p)
+            coefficient /= content;
+}
+
+/**
+ * @brief Replaces r with the primitive part of a pseudo-remainder of r by b.
+ *
+ * @return `false` if an intermediate coefficient would overflow int64_t; otherwise, `true`.
+ *
+ * Each step scales r by the cofactor of the leading coefficients, so the division stays in the
+ * integers, and divides the result by its content to keep the coefficients small.
+ */
+static bool pseudoRemainder(std::vector<int64_t> &r, const std::vector<int64_t> &b)
+{
+    while (!r.empty() && r.size() >= b.size())
+    {
+        int64_t common = std::gcd(r.back(), b.back());
+        int64_t scaleR = b.back() / common;
+        int64_t scaleB = r.back() / common;
+        size_t shift = r.size() - b.size();
+        for (size_t i = 0; i < r.size(); i++)
+        {
+            int64_t value;
+            if (__builtin_mul_overflow(r[i], scaleR, &value))
+                return false;
+            int64_t subtracted;
+            if (i >= shift && (__builtin_mul_overflow(b[i - shift], scaleB, &subtracted) ||
+                               __builtin_sub_overflow(value, subtracted, &value)))
+                return false;
+            r[i] = value;
+        }
+        trimLeading(r, 0.0);
+        makePrimitive(r);
+    }
+    return true;
+}
+
+/**
+ * @brief Computes the GCD of two integer vectors with the primitive Euclidean algorithm.
+ *
+ * @return `false` if an intermediate coefficient would overflow int64_t; otherwise, `true`.
+ *
+ * The GCD over the integers is the GCD of the contents times the GCD of the primitive parts, which
+ * is the last non-zero primitive pseudo-remainder. It is returned with a positive leading coefficient.
+ */
+static bool primitiveGcd(std::vector<int64_t> a, std::vector<int64_t> b, std::vector<int64_t> &gcd)
+{
+    trimLeading(a, 0.0);
+    trimLeading(b, 0.0);
+    int64_t content = std::gcd(contentOf(a), contentOf(b));
+    makePrimitive(a);
+    makePrimitive(b);
+    if (a.size() < b.size())
+        a.swap(b);
+
+    while (!b.empty())
+    {
+        if (!pseudoRemainder(a, b))
+            return false;
+        a.swap(b);
+    }
+
+    if (a.size() == 1)
+        a[0] = 1;
+    int64_t sign = !a.empty() && a.back() < 0 ? -1 : 1;
+    for (int64_t &coefficient : a)
+    {
+        if (__builtin_mul_overflow(coefficient, sign * content, &coefficient))
+            return false;
+    }
+    gcd.swap(a);
+    return true;
+}
+
+/**
+ * @brief Computes the greatest common divisor of two coefficient vectors.
+ *
+ * @param a Coefficients of the first polynomial, indexed by degree.
+ * @param b Coefficients of the second polynomial, indexed by degree.
+ * @param gcd Receives the coefficients of the GCD: monic for double and ModInt, primitive times the GCD of
+ *            the contents with a positive leading coefficient for int64_t; empty if both operands are zero.
+ * @return `false` if an int64_t intermediate would overflow; otherwise, `true`.
+ *
+ * ModInt vectors, over an exact field, go halfway down the remainder sequence at a time with `halfGcd`
+ * while the smaller operand has degree `halfGcdThreshold` or more, and finish with the classical
+ * algorithm. Floating-point remainders are never exactly zero, so for double the classical algorithm
+ * runs on monic remainders and drops the leading coefficients within `zeroTolerance` of the largest
+ * coefficient of the operands.
+ */
+template <typename A>
+bool gcdCoefficients(const std::vector<A> &a, const std::vector<A> &b, std::vector<A> &gcd)
+{
+    if constexpr (std::is_same<A, int64_t>::value)
+    {
+        return primitiveGcd(a, b, gcd);
+    }
+    else
+    {
+        double tolerance = 0.0;
+        if constexpr (std::is_same<A, double>::value)
+        {
+            double largest = 0.0;
+            for (double coefficient : a)
+                largest = std::max(largest, std::abs(coefficient));
+            for (double coefficient : b)
+                largest = std::max(largest, std::abs(coefficient));
+            tolerance = divisionSettings().zeroTolerance * largest;
+        }
+
+        std::vector<A> first(a), second(b), quotient;
+        trimLeading(first, tolerance);
+        trimLeading(second, tolerance);
+        if (first.size() < second.size())
+            first.swap(second);
+
+        while (!second.empty())
+        {
+            if constexpr (std::is_same<A, ModInt>::value)
+            {
+                if (degreeOf(second) >= divisionSettings().halfGcdThreshold && degreeOf(first) > degreeOf(second))
+                {
+                    std::vector<A> c, d;
+                    halfGcd(first, second).apply(first, second, c, d);
+                    first.swap(c);
+                    second.swap(d);
+                    if (second.empty())
+                        break;
+                }
+            }
+            if (std::is_same<A, double>::value)
+                makeMonic(second);
+            euclidStep(first, second, quotient, tolerance);
+        }
+
+        makeMonic(first);
+        gcd.swap(first);
+        return true;
+    }
+}
+
+/**
+ * @brief Tells whether a coefficient is invertible: any non-zero one over a field, only 1 and -1 for int64_t.
+ */
+static bool isUnit(double value)
+{
+    return value != 0.0;
+}
+
+static bool isUnit(int64_t value)
+{
+    return value == 1 || value == -1;
+}
+
+static bool isUnit(ModInt value)
+{
+    return value != ModInt(0);
+}
+
+// Outcome of a sparse long division
+enum class SparseDivision
+{
+    Done,
+    NotExact,
+    Dense
+};
+
+/**
+ * @brief Divides two polynomials term by term, without expanding them into coefficient arrays.
+ *
+ * @param a The dividend.
+ * @param b The divisor, non-zero.
+ * @param quotient Receives a div b, unless it is null.
+ * @param remainder Receives a mod b.
+ * @return `NotExact` if the quotient does not have integer coefficients (int64_t); `Dense` if the
+ *         quotient fills in, leaving both outputs untouched; otherwise, `Done`.
+ *
+ * The remainder is kept as a map of its non-zero terms, and each step cancels its leading term with
+ * one term of the quotient, at a cost of O(t log r) for a divisor of t terms whatever the degrees,
+ * so a dividend of huge degree with a sparse quotient, such as (x^n - 1) / (x^k - 1), is cheap.
+ * Once the quotient has `minDenseTerms` terms and these steps have cost `denseRatio` of the
+ * degrees it spans, which the dense kernels process in about linear time, the division gives up
+ * with `Dense`: so does x^n / (x^3 - 1), whose quotient is a third full.
+ */
+template <typename T>
+static SparseDivision sparseDivide(const BasicList<T> &a, const BasicList<T> &b, BasicList<T> *quotient,
+                                   BasicList<T> &remainder)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+
+    std::map<int, Accumulator, std::greater<int>> rest;
+    std::vector<Accumulator> dividend;
+    for (const BasicNode<T> *node = a.getHead(); node != nullptr; node = node->getNext())
+    {
+        rest.emplace_hint(rest.end(), node->getDegree(), Accumulator(node->getCoefficient()));
+        dividend.push_back(Accumulator(node->getCoefficient()));
+    }
+    std::vector<std::pair<int, Accumulator>> divisor;
+    for (const BasicNode<T> *node = b.getHead(); node != nullptr; node = node->getNext())
+        divisor.emplace_back(node->getDegree(), Accumulator(node->getCoefficient()));
+
+    const StorageSettings &storage = storageSettings();
+    Accumulator largest = largestMagnitude(dividend);
+    Accumulator inverse = reciprocal(divisor[0].second);
+    BasicList<T> q;
+    int top = -1;
+    int terms = 0;
+    while (!rest.empty() && rest.begin()->first >= divisor[0].first)
+    {
+        int degree = rest.begin()->first - divisor[0].first;
+        Accumulator coefficient;
+        if (!divideExactly(rest.begin()->second, divisor[0].second, inverse, coefficient))
+            return SparseDivision::NotExact;
+
+        if (top < 0)
+            top = degree;
+        if (++terms >= storage.minDenseTerms &&
+            (double)terms * divisor.size() >= storage.denseRatio * (top - degree + 1.0))
+            return SparseDivision::Dense;
+
+        // The leading term cancels by construction; the others may cancel, up to rounding noise
+        rest.erase(rest.begin());
+        for (size_t i = 1; i < divisor.size(); i++)
+        {
+            auto term = rest.emplace(divisor[i].first + degree, Accumulator(0)).first;
+            term->second -= coefficient * divisor[i].second;
+            if (isNoise(term->second, largest))
+                rest.erase(term);
+        }
+        if (quotient != nullptr && (T)coefficient != T(0))
+            q.append((T)coefficient, degree);
+    }
+
+    BasicList<T> r;
+    for (const auto &[degree, coefficient] : rest)
+        if ((T)coefficient != T(0))
+            r.append((T)coefficient, degree);
+
+    if (quotient != nullptr)
+        *quotient = std::move(q);
+    remainder = std::move(r);
+    return SparseDivision::Done;
+}
+
+/**
+ * @brief Computes the remainder of a sparse polynomial term by term.
+ *
+ * @param a The dividend.
+ * @param modulus The divisor, whose leading coefficient must be a unit.
+ * @param remainder Receives the coefficients of a mod m, trimmed.
+ * @return `false` if a reduction is not exact (int64_t only); otherwise, `true`.
+ *
+ * Walks the terms of a from the lowest degree up, keeping x^e mod m for the current degree e and
+ * advancing it by the gap to the next term with `Modulus::monomial`, so the cost depends on the
+ * number of terms of a and on deg m, and only logarithmically on deg a.
+ */
+template <typename T>
+static bool reduceTerms(const BasicList<T> &a, const Modulus<typename BasicList<T>::Accumulator> &modulus,
+                        std::vector<typename BasicList<T>::Accumulator> &remainder)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+
+    std::vector<std::pair<int, Accumulator>> terms;
+    for (const BasicNode<T> *node = a.getHead(); node != nullptr; node = node->getNext())
+        terms.emplace_back(node->getDegree(), Accumulator(node->getCoefficient()));
+
+    std::vector<Accumulator> power(1, Accumulator(1)), step;
+    std::vector<Accumulator> dividend;
+    if (!modulus.reduce(power))
+        return false;
+    remainder.clear();
+    int exponent = 0;
+    for (auto term = terms.rbegin(); term != terms.rend(); ++term)
+    {
+        if (term->first > exponent)
+        {
+            if (!modulus.monomial(term->first - exponent, step))
+                return false;
+            power = multiplyVectors(power, step);
+            if (!modulus.reduce(power))
+                return false;
+            exponent = term->first;
+        }
+        if (remainder.size() < power.size())
+            remainder.resize(power.size(), Accumulator(0));
+        for (size_t i = 0; i < power.size(); i++)
+            remainder[i] += term->second * power[i];
+        dividend.push_back(term->second);
+    }
+
+    dropNoise(remainder, largestMagnitude(dividend));
+    while (!remainder.empty() && remainder.back() == Accumulator(0))
+        remainder.pop_back();
+    return true;
+}
+
+/**
+ * @brief Fails like an allocation when the arrays of a dense operation cannot fit in the physical memory.
+ *
+ * @param degree The degree of the largest operand.
+ *
+ * With overcommitted memory, a huge array is handed out and only fails when it is written, where
+ * the process is killed instead of getting std::bad_alloc. A dense division holds a few arrays the
+ * size of the dividend, so one that could not fit in the memory is refused up front.
+ */
+template <typename A>
+static void reserveDense(int degree)
+{
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && pageSize > 0 && 4.0 * (degree + 1.0) * sizeof(A) > (double)pages * pageSize)
+        throw std::bad_alloc();
+}
+
+/**
+ * @brief Divides two polynomials expanded into coefficient arrays in the accumulator type.
+ *
+ * Goes through `divideCoefficients`, so a large division costs a few multiplications. For
+ * floating-point coefficients, remainder coefficients within `zeroTolerance` of the largest
+ * coefficient of the dividend are rounding noise and are dropped.
+ */
+template <typename T>
+static bool divideDense(const BasicList<T> &a, const BasicList<T> &b, BasicList<T> &quotient, BasicList<T> &remainder)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+    reserveDense<Accumulator>(a.getDegree());
+
+    std::vector<Accumulator> x = a.getCoefficients();
+    std::vector<Accumulator> y = b.getCoefficients();
+    std::vector<Accumulator> q, r;
+    if (!divideCoefficients(x, y, q, r))
+        return false;
+    dropNoise(r, largestMagnitude(x));
+
+    quotient = BasicList<T>::fromCoefficients(q);
+    remainder = BasicList<T>::fromCoefficients(r);
+    return true;
+}
+
+/**
+ * @brief Divides two polynomials.
+ *
+ * @param a The dividend.
+ * @param b The divisor.
+ * @param quotient Receives a div b.
+ * @param remainder Receives a mod b, of degree below deg b.
+ * @return `false` if b is zero, or if the quotient does not have integer coefficients (int64_t); otherwise, `true`.
+ *
+ * A dense dividend (see `isDense`) is expanded into a coefficient array and divided with the fast
+ * kernels of `divideCoefficients`. A sparse one goes through the term-by-term long division, whose
+ * cost does not depend on the degrees, and only falls back to the arrays if the quotient fills in.
+ */
+template <typename T>
+bool dividePolynomials(const BasicList<T> &a, const BasicList<T> &b, BasicList<T> &quotient, BasicList<T> &remainder)
+{
+    if (b.isEmpty())
+        return false;
+    if (a.isEmpty() || a.getDegree() < b.getDegree())
+    {
+        quotient = BasicList<T>();
+        remainder = a;
+        return true;
+    }
+
+    if (!isDense(a))
+    {
+        SparseDivision division = sparseDivide(a, b, &quotient, remainder);
+        if (division != SparseDivision::Dense)
+            return division == SparseDivision::Done;
+    }
+    return divideDense(a, b, quotient, remainder);
+}
+
+/**
+ * @brief Computes the remainder of two polynomials.
+ *
+ * @param a The dividend.
+ * @param b The divisor.
+ * @param remainder Receives a mod b, of degree below deg b.
+ * @return `false` like `dividePolynomials`.
+ *
+ * Works like `dividePolynomials`, except that a sparse dividend whose quotient fills in is reduced
+ * term by term with `reduceTerms` when the leading coefficient of b is a unit, so the remainder of
+ * a sparse polynomial of huge degree, such as x^1000000000 + 1 mod x^2 + 1, never expands the
+ * quotient. An int64_t divisor with another leading coefficient goes through the quotient, since
+ * the reductions of the single terms need not be exact even when the whole division is.
+ */
+template <typename T>
+bool polynomialRemainder(const BasicList<T> &a, const BasicList<T> &b, BasicList<T> &remainder)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+    if (b.isEmpty())
+        return false;
+    if (a.isEmpty() || a.getDegree() < b.getDegree())
+    {
+        remainder = a;
+        return true;
+    }
+
+    if (!isDense(a))
+    {
+        SparseDivision division = sparseDivide<T>(a, b, nullptr, remainder);
+        if (division != SparseDivision::Dense)
+            return division == SparseDivision::Done;
+
+        if (isUnit(Accumulator(b.getHead()->getCoefficient())))
+        {
+            std::vector<Accumulator> r;
+            if (!reduceTerms(a, Modulus<Accumulator>(b.getCoefficients()), r))
+                return false;
+            remainder = BasicList<T>::fromCoefficients(r);
+            return true;
+        }
+    }
+
+    BasicList<T> quotient;
+    return divideDense(a, b, quotient, remainder);
+}
+
+/**
+ * @brief Scales a non-zero polynomial like `gcdCoefficients` normalizes a GCD whose other operand is zero.
+ *
+ * Over a field, the result is monic; for int64_t, the content is kept and only the sign changes.
+ */
+template <typename T>
+static BasicList<T> normalizeGcd(const BasicList<T> &p)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+
+    Accumulator leading = Accumulator(p.getHead()->getCoefficient());
+    Accumulator scale;
+    if constexpr (std::is_same<Accumulator, int64_t>::value)
+        scale = leading < 0 ? -1 : 1;
+    else
+        scale = reciprocal(leading);
+
+    BasicList<T> normalized;
+    for (const BasicNode<T> *node = p.getHead(); node != nullptr; node = node->getNext())
+    {
+        T coefficient = (T)(Accumulator(node->getCoefficient()) * scale);
+        if (node == p.getHead() && !std::is_same<Accumulator, int64_t>::value)
+            coefficient = T(1);
+        if (coefficient != T(0))
+            normalized.append(coefficient, node->getDegree());
+    }
+    return normalized;
+}
+
+/**
+ * @brief Computes the greatest common divisor of two polynomials.
+ *
+ * @param a The first polynomial.
+ * @param b The second polynomial.
+ * @param gcd Receives the GCD, normalized as described in `gcdCoefficients`.
+ * @return `false` if an int64_t intermediate would overflow; otherwise, `true`.
+ *
+ * While an operand is sparse, the Euclidean steps run on the lists with `polynomialRemainder`,
+ * which never expands a sparse operand of large degree; once both are dense (or an int64_t step
+ * is not exact, which the pseudo-remainders handle), the rest goes through `gcdCoefficients`.
+ */
+template <typename T>
+bool polynomialGcd(const BasicList<T> &a, const BasicList<T> &b, BasicList<T> &gcd)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+
+    BasicList<T> first(a), second(b);
+    if (first.isEmpty() || (!second.isEmpty() && first.getDegree() < second.getDegree()))
+        std::swap(first, second);
+
+    while (!second.isEmpty() && !(isDense(first) && isDense(second)))
+    {
+        BasicList<T> remainder;
+        if (!polynomialRemainder(first, second, remainder))
+            break;
+        first = std::move(second);
+        second = std::move(remainder);
+    }
+    if (first.isEmpty())
+    {
+        gcd = BasicList<T>();
+        return true;
+    }
+    if (second.isEmpty())
+    {
+        gcd = normalizeGcd(first);
+        return true;
+    }
+
+    reserveDense<Accumulator>(first.getDegree());
+    std::vector<Accumulator> g;
+    if (!gcdCoefficients(first.getCoefficients(), second.getCoefficients(), g))
+        return false;
+    gcd = BasicList<T>::fromCoefficients(g);
+    return true;
+}
+
+template std::vector<double> seriesInverse(const std::vector<double> &f, int n);
+template std::vector<int64_t> seriesInverse(const std::vector<int64_t> &f, int n);
+template std::vector<ModInt> seriesInverse(const std::vector<ModInt> &f, int n);
+
+template bool longDivide(const std::vector<double> &a, const std::vector<double> &b,
+                         std::vector<double> &quotient, std::vector<double> &remainder);
+template bool longDivide(const std::vector<int64_t> &a, const std::vector<int64_t> &b,
+                         std::vector<int64_t> &quotient, std::vector<int64_t> &remainder);
+template bool longDivide(const std::vector<ModInt> &a, const std::vector<ModInt> &b,
+                         std::vector<ModInt> &quotient, std::vector<ModInt> &remainder);
+
+template std::vector<double> reversedInverse(const std::vector<double> &b, int n);
+template std::vector<int64_t> reversedInverse(const std::vector<int64_t> &b, int n);
+template std::vector<ModInt> reversedInverse(const std::vector<ModInt> &b, int n);
+
+template bool divideCoefficients(const std::vector<double> &a, const std::vector<double> &b,
+                                 std::vector<double> &quotient, std::vector<double> &remainder);
+template bool divideCoefficients(const std::vector<int64_t> &a, const std::vector<int64_t> &b,
+                                 std::vector<int64_t> &quotient, std::vector<int64_t> &remainder);
+template bool divideCoefficients(const std::vector<ModInt> &a, const std::vector<ModInt> &b,
+                                 std::vector<ModInt> &quotient, std::vector<ModInt> &remainder);
+
+template bool divideCoefficients(const std::vector<double> &a, const std::vector<double> &b, const std::vector<double> &inverse,
+                                 std::vector<double> &quotient, std::vector<double> &remainder);
+template bool divideCoefficients(const std::vector<int64_t> &a, const std::vector<int64_t> &b, const std::vector<int64_t> &inverse,
+                                 std::vector<int64_t> &quotient, std::vector<int64_t> &remainder);
+template bool divideCoefficients(const std::vector<ModInt> &a, const std::vector<ModInt> &b, const std::vector<ModInt> &inverse,
+                                 std::vector<ModInt> &quotient, std::vector<ModInt> &remainder);
+
+template bool gcdCoefficients(const std::vector<double> &a, const std::vector<double> &b, std::vector<double> &gcd);
+template bool gcdCoefficients(const std::vector<int64_t> &a, const std::vector<int64_t> &b, std::vector<int64_t> &gcd);
+template bool gcdCoefficients(const std::vector<ModInt> &a, const std::vector<ModInt> &b, std::vector<ModInt> &gcd);
+
+template bool dividePolynomials(const BasicList<float> &a, const BasicList<float> &b,
+                                BasicList<float> &quotient, BasicList<float> &remainder);
+template bool dividePolynomials(const BasicList<double> &a, const BasicList<double> &b,
+                                BasicList<double> &quotient, BasicList<double> &remainder);
+template bool dividePolynomials(const BasicList<int64_t> &a, const BasicList<int64_t> &b,
+                                BasicList<int64_t> &quotient, BasicList<int64_t> &remainder);
+template bool dividePolynomials(const BasicList<ModInt> &a, const BasicList<ModInt> &b,
+                                BasicList<ModInt> &quotient, BasicList<ModInt> &remainder);
+
+template bool polynomialRemainder(const BasicList<float> &a, const BasicList<float> &b, BasicList<float> &remainder);
+template bool polynomialRemainder(const BasicList<double> &a, const BasicList<double> &b, BasicList<double> &remainder);
+template bool polynomialRemainder(const BasicList<int64_t> &a, const BasicList<int64_t> &b, BasicList<int64_t> &remainder);
+template bool polynomialRemainder(const BasicList<ModInt> &a, const BasicList<ModInt> &b, BasicList<ModInt> &remainder);
+
+template bool polynomialGcd(const BasicList<float> &a, const BasicList<float> &b, BasicList<float> &gcd);
+template bool polynomialGcd(const BasicList<double> &a, const BasicList<double> &b, BasicList<double> &gcd);
+template bool polynomialGcd(const BasicList<int64_t> &a, const BasicList<int64_t> &b, BasicList<int64_t> &gcd);
+template bool polynomialGcd(const BasicList<ModInt> &a, const BasicList<ModInt> &b, BasicList<ModInt> &gcd);
+
+template class Modulus<double>;
+template class Modulus<int64_t>;
+template class Modulus<ModInt>;
@@ -0,0 +1,201 @@
+#include "../include/Expression.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <queue>
+#include <utility>
+
+/**
+ * @class BasicExpression
+ * @brief Lazy sum of signed products of polynomials, such as `a + b - c * d`.
+ *
+ * Parsing only records the structure of the expression; the operands are filled in afterwards and
+ * nothing is computed until `evaluateInto`. There, every product with more than one factor is
+ * multiplied once, and then all the summands are merged together in a single k-way pass that
+ * appends straight into the destination list, so a sum of many operands creates no intermediate lists.
+ */
+
+/**
+ * @brief Parses an expression over operand letters.
+ *
+ * @param text The expression, e.g. `a + b - c * d`. Operands are letters, `a` being the first operand
+ *             line, `b` the second and so on; `*` binds tighter than `+` and `-`, and a leading sign is allowed.
+ * @return `true` if the expression is valid; otherwise, an error message is printed and `false` is returned.
+ *
+ * On success the operand list is sized to the highest letter used and every operand is emptied.
+ */
+template <typename T>
+bool BasicExpression<T>::parse(const std::string &text)
+{
+    products.clear();
+
+    T sign(1);
+    bool expectOperand = true;
+    bool newProduct = true;
+    bool leading = true;
+    int highest = -1;
+
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        char symbol = (char)std::tolower((unsigned char)text[i]);
+        if (std::isspace((unsigned char)symbol))
+            continue;
+
+        if (expectOperand && symbol >= 'a' && symbol <= 'z')
+        {
+            if (newProduct)
+                products.push_back({sign, {}});
+            products.back().factors.push_back(symbol - 'a');
+            highest = std::max(highest, symbol - 'a');
+            newProduct = false;
+            expectOperand = false;
+        }
+        else if ((symbol == '+' || symbol == '-') && (!expectOperand || leading))
+        {
+            sign = symbol == '-' ? T(-1) : T(1);
+            newProduct = true;
+            expectOperand = true;
+        }
+        else if (symbol == '*' && !expectOperand)
+        {
+            expectOperand = true;
+        }
+        else
+        {
+            errorOutput() << "Erro: Expressão inválida na coluna " << i + 1 << ": " << text << std::endl;
+            products.clear();
+            return false;
+        }
+        leading = false;
+    }
+
+    if (expectOperand)
+    {
+        errorOutput() << "Erro: Expressão incompleta: " << text << std::endl;
+        products.clear();
+        return false;
+    }
+
+    operands.resize(highest + 1);
+    for (BasicList<T> &poly : operands)
+        poly.reset();
+    return true;
+}
+
+/**
+ * @brief Retrieves the number of operand lines the expression needs.
+ *
+ * @return One more than the index of the highest operand letter used.
+ */
+template <typename T>
+int BasicExpression<T>::operandCount() const
+{
+    return (int)operands.size();
+}
+
+/**
+ * @brief Gives access to an operand so it can be populated.
+ *
+ * @param index The operand index (`0` for `a`).
+ * @return Reference to the operand polynomial.
+ */
+template <typename T>
+BasicList<T> &BasicExpression<T>::operand(int index)
+{
+    return operands[index];
+}
+
+/**
+ * @brief Gives read access to an operand.
+ *
+ * @param index The operand index (`0` for `a`).
+ * @return Reference to the operand polynomial.
+ */
+template <typename T>
+const BasicList<T> &BasicExpression<T>::operand(int index) const
+{
+    return operands[index];
+}
+
+/**
+ * @brief Evaluates the expression and writes the result into a list.
+ *
+ * @param destination The List object receiving the result; its previous terms are discarded.
+ *
+ * Products of several factors are computed first (each factor is multiplied in once). The summands
+ * are then merged in one pass: a max-heap holds the current term of every summand, like degrees are
+ * added up as they are popped, and each finished term is appended to `destination`. The merge costs
+ * O(T log k) for T terms in k summands, without any intermediate sum.
+ */
+template <typename T>
+void BasicExpression<T>::evaluateInto(BasicList<T> &destination) const
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+
+    std::vector<BasicList<T>> partials;
+    partials.reserve(products.size());
+
+    // (current node, sign) of every summand
+    std::vector<std::pair<BasicNode<T> *, T>> sources;
+    sources.reserve(products.size());
+
+    for (const Product &product : products)
+    {
+        if (product.factors.size() == 1)
+        {
+            sources.push_back({operands[product.factors[0]].getHead(), product.sign});
+            continue;
+        }
+
+        BasicList<T> partial = operands[product.factors[0]] * operands[product.factors[1]];
+        for (size_t i = 2; i < product.factors.size(); i++)
+            partial = partial * operands[product.factors[i]];
+        partials.push_back(std::move(partial));
+        sources.push_back({partials.back().getHead(), product.sign});
+    }
+
+    destination.reset();
+
+    // (degree, source index); std::priority_queue is a max-heap on the degree
+    std::priority_queue<std::pair<int, int>> heap;
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        if (sources[i].first != nullptr)
+            heap.push({sources[i].first->getDegree(), (int)i});
+    }
+
+    while (!heap.empty())
+    {
+        int degree = heap.top().first;
+        Accumulator sum(0);
+        while (!heap.empty() && heap.top().first == degree)
+        {
+            int source = heap.top().second;
+            heap.pop();
+
+            sum += (Accumulator)sources[source].second * (Accumulator)sources[source].first->getCoefficient();
+            sources[source].first = sources[source].first->getNext();
+            if (sources[source].first != nullptr)
+                heap.push({sources[source].first->getDegree(), source});
+        }
+
+        T coeff = (T)sum;
+        if (coeff != T(0))
+            destination.append(coeff, degree);
+    }
+}
+
+/**
+ * @brief Empties every operand while keeping their storage for the next expression.
+ */
+template <typename T>
+void BasicExpression<T>::reset()
+{
+    for (BasicList<T> &poly : operands)
+        poly.reset();
+}
+
+template class BasicExpression<float>;
+template class BasicExpression<double>;
+template class BasicExpression<int64_t>;
+template class BasicExpression<ModInt>;
@@ -1,9 +1,37 @@
 #include "../include/FileProcessor.h"
+#include "../include/MultipointEvaluation.h"
+#include "../include/Division.h"
+#include "../include/Power.h"
+#include "../include/LineReader.h"
+#include "../include/ThreadPool.h"
+#include "../include/BinaryFormat.h"
+#include "../include/Instrumentation.h"
+#include "../include/ResultCache.h"
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <climits>
 #include <cmath>
+#include <deque>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @brief Returns the settings of the command results.
+ *
+ * @return Reference to the process-wide OutputSettings object, set from the command line.
+ */
+OutputSettings &outputSettings()
+{
+    static OutputSettings settings;
+    return settings;
+}
 
 /**
  * @brief Trims leading and trailing whitespace from a string.
@@ -26,8 +54,8 @@ std::string trim(const std::string &str)
 /**
  * @brief Reads a file and returns a vector of trimmed, non-empty lines.
  *
- * This function opens the specified file, reads its contents line by line, trims each line,
- * and stores non-empty lines into a vector.
+ * This function reads the specified file through a `LineReader` and stores its trimmed,
+ * non-empty lines into a vector. `processFile` streams the lines instead of calling it.
  *
  * @param filename The path to the file to be read.
  * @return A vector containing trimmed, non-empty lines from the file.
@@ -36,24 +64,19 @@ std::string trim(const std::string &str)
  */
 std::vector<std::string> trimFileLines(const std::string &filename)
 {
-    std::ifstream inputFile(filename);
-    if (!inputFile)
+    LineReader reader(filename);
+    if (!reader.isOpen())
     {
-        std::cerr << "Erro: Não foi possível abrir o arquivo '" << filename << "' para leitura." << std::endl;
+        errorOutput() << "Erro: Não foi possível abrir o arquivo '" << filename << "' para leitura." << std::endl;
         exit(1);
     }
 
     std::vector<std::string> lines;
-    std::string line;
-    while (std::getline(inputFile, line))
+    std::string_view line;
+    while (reader.next(line))
     {
-        line = trim(line);
-        if (!line.empty())
-        {
-            lines.push_back(line);
-        }
+        lines.emplace_back(line);
     }
-    inputFile.close();
     return lines;
 }
 
@@ -67,7 +90,7 @@ std::vector<std::string> trimFileLines(const std::string &filename)
  * @param line The input line from which to extract the command.
  * @param command Pointer to a character where the extracted command will be stored.
  */
-void getCommand(const std::string &line, char *command)
+void getCommand(std::string_view line, char *command)
 {
     if (line.length() == 1)
     {
@@ -79,200 +102,1544 @@ void getCommand(const std::string &line, char *command)
     }
 }
 
+/**
+ * @brief Checks whether a character separates the values of a line.
+ */
+static bool isSeparator(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+/**
+ * @brief Returns the first character at or after `cursor` that is not a separator.
+ */
+static const char *skipSeparators(const char *cursor, const char *end)
+{
+    while (cursor != end && isSeparator(*cursor))
+        cursor++;
+    return cursor;
+}
+
+/**
+ * @brief Checks that a scanned value ends at a separator or at the end of the line.
+ *
+ * @return The end of the value, or nullptr if the value was malformed or runs into other characters.
+ */
+static const char *endOfValue(const char *valueEnd, const char *end)
+{
+    if (valueEnd == nullptr || (valueEnd != end && !isSeparator(*valueEnd)))
+        return nullptr;
+    return valueEnd;
+}
+
+/**
+ * @brief Prints the column and the text of a malformed value.
+ *
+ * @param line The line being parsed.
+ * @param column The 1-based column where the malformed value starts.
+ * @param what Description of the malformed value, e.g. "par coeficiente/grau".
+ */
+static void reportMalformed(std::string_view line, size_t column, const char *what)
+{
+    size_t stop = column - 1;
+    while (stop < line.size() && !isSeparator(line[stop]))
+        stop++;
+    errorOutput() << "Erro: " << what << " inválido na coluna " << column << ": '"
+              << line.substr(column - 1, stop - column + 1) << "'" << std::endl;
+}
+
+/**
+ * @brief Parses the coefficient and degree pairs of a line in place.
+ *
+ * @param line The input line containing coefficient and degree pairs.
+ * @param terms Receives the (degree, coefficient) pairs in the order of the line (previous contents are discarded).
+ * @return `0` if the whole line was parsed; otherwise, the 1-based column of the first malformed pair,
+ *         with `terms` holding the pairs before it.
+ *
+ * Values are scanned straight from the line buffer with `std::from_chars` through
+ * `CoefficientTraits<T>::scan`, without copies, allocations (once `terms` has grown) or locale lookups.
+ * A pair is malformed if either value is not a number of the expected type (the degree is an `int`),
+ * if a value runs into other characters, or if the line ends after a coefficient.
+ */
+template <typename T>
+size_t parseTerms(std::string_view line, std::vector<std::pair<int, T>> &terms)
+{
+    terms.clear();
+    const char *begin = line.data();
+    const char *end = begin + line.size();
+    const char *cursor = skipSeparators(begin, end);
+
+    while (cursor != end)
+    {
+        const char *pair = cursor;
+        T coefficient;
+        int degree;
+
+        cursor = endOfValue(CoefficientTraits<T>::scan(cursor, end, coefficient), end);
+        if (cursor != nullptr)
+        {
+            cursor = skipSeparators(cursor, end);
+            cursor = cursor == end ? nullptr : endOfValue(scanNumber(cursor, end, degree), end);
+        }
+        if (cursor == nullptr)
+            return (size_t)(pair - begin) + 1;
+
+        terms.emplace_back(degree, coefficient);
+        cursor = skipSeparators(cursor, end);
+    }
+    return 0;
+}
+
+/**
+ * @brief Stores parsed terms into an empty polynomial, with the same result as inserting them one by one.
+ *
+ * @param terms The (degree, coefficient) pairs in the order of the line; reordered in place.
+ * @param poly The empty polynomial receiving the terms.
+ *
+ * Lines are usually written in descending degree order, and are then stored as they are. Otherwise
+ * the terms are stably sorted by descending degree and the coefficients of equal degrees are summed
+ * in their original order, as `insert` would. The storage is sized once: a coefficient array when
+ * the terms are dense enough for it, or a node pool reserved for every term.
+ */
+template <typename T>
+static void storeTerms(std::vector<std::pair<int, T>> &terms, BasicList<T> &poly)
+{
+    auto higher = [](const std::pair<int, T> &a, const std::pair<int, T> &b) { return a.first > b.first; };
+    if (!std::is_sorted(terms.begin(), terms.end(), higher) ||
+        std::adjacent_find(terms.begin(), terms.end(), [](const std::pair<int, T> &a, const std::pair<int, T> &b)
+                           { return a.first == b.first; }) != terms.end())
+    {
+        std::stable_sort(terms.begin(), terms.end(), higher);
+        size_t unique = 0;
+        for (size_t i = 0; i < terms.size(); i++)
+        {
+            if (unique > 0 && terms[unique - 1].first == terms[i].first)
+                terms[unique - 1].second = terms[unique - 1].second + terms[i].second;
+            else
+                terms[unique++] = terms[i];
+        }
+        terms.resize(unique);
+    }
+
+    // Negative degrees (at the end) go through insert, which reports them
+    size_t valid = 0;
+    int count = 0;
+    while (valid < terms.size() && terms[valid].first >= 0)
+        count += terms[valid++].second != T(0);
+
+    const StorageSettings &settings = storageSettings();
+    if (count > 0 && count >= settings.minDenseTerms && count >= settings.denseRatio * (terms[0].first + 1.0f))
+    {
+        BasicDensePolynomial<T> coefficients;
+        for (size_t i = 0; i < valid; i++)
+        {
+            if (terms[i].second != T(0))
+                coefficients.setCoefficient(terms[i].first, terms[i].second);
+        }
+        poly = BasicList<T>(std::move(coefficients));
+    }
+    else
+    {
+        poly.reserve(count);
+        for (size_t i = 0; i < valid; i++)
+        {
+            if (terms[i].second != T(0))
+                poly.append(terms[i].second, terms[i].first);
+        }
+    }
+
+    for (size_t i = valid; i < terms.size(); i++)
+        poly.insert(terms[i].second, terms[i].first);
+}
+
 /**
  * @brief Populates a polynomial from a line containing coefficient and degree pairs.
  *
- * This function parses a line containing pairs of coefficients and degrees,
- * and inserts each term into the provided polynomial list.
+ * This function parses a line containing pairs of coefficients and degrees with `parseTerms`
+ * and adds each term to the provided polynomial list. An empty polynomial is filled in one pass
+ * by `storeTerms`; otherwise, the terms are inserted one by one. A malformed pair is reported with
+ * its column, and the pairs before it are kept.
  *
  * @param line The input line containing coefficient and degree pairs.
  * @param poly Reference to a `List` object representing the polynomial to be populated.
- *
- * @throws std::cerr If the input line is empty, an error message is printed and the program exits.
+ * @return `false` if the line is empty, with an error message printed; otherwise, `true`.
  */
-void populatePolynomial(const std::string &line, List &poly)
+template <typename T>
+bool populatePolynomial(std::string_view line, BasicList<T> &poly)
 {
     if (line.empty())
     {
-        std::cerr << "Erro: Linha de polinômio inválida." << std::endl;
-        exit(1);
+        errorOutput() << "Erro: Linha de polinômio inválida." << std::endl;
+        return false;
+    }
+
+    // Reused from line to line, so parsing allocates only while the longest line seen so far grows
+    static thread_local std::vector<std::pair<int, T>> terms;
+    size_t column = parseTerms(line, terms);
+    if (column != 0)
+        reportMalformed(line, column, "Par coeficiente/grau");
+
+    if (poly.isEmpty())
+    {
+        storeTerms(terms, poly);
+        return true;
+    }
+
+    for (const std::pair<int, T> &term : terms)
+    {
+        poly.insert(term.second, term.first);
+    }
+    return true;
+}
+
+/**
+ * @brief Parses a line of whitespace-separated evaluation points.
+ *
+ * @param line The input line containing the x values.
+ * @param points Vector receiving the parsed values (previous contents are discarded).
+ *
+ * Values are scanned in place like the pairs of `parseTerms`. A malformed value is reported with
+ * its column, and the values before it are kept.
+ *
+ * @return `false` if the line holds no valid value, with an error message printed; otherwise, `true`.
+ */
+template <typename T>
+bool populatePoints(std::string_view line, std::vector<T> &points)
+{
+    points.clear();
+    const char *begin = line.data();
+    const char *end = begin + line.size();
+    const char *cursor = skipSeparators(begin, end);
+
+    while (cursor != end)
+    {
+        T x;
+        const char *next = endOfValue(CoefficientTraits<T>::scan(cursor, end, x), end);
+        if (next == nullptr)
+        {
+            reportMalformed(line, (size_t)(cursor - begin) + 1, "Valor de x");
+            break;
+        }
+        points.push_back(x);
+        cursor = skipSeparators(next, end);
     }
 
-    std::istringstream iss(line);
-    float coefficient;
-    int degree;
-    while (iss >> coefficient >> degree)
+    if (points.empty())
     {
-        poly.insert(coefficient, degree);
+        errorOutput() << "Erro: Linha de pontos de avaliação inválida." << std::endl;
+        return false;
     }
+    return true;
+}
+
+/**
+ * @brief Parses the exponent line of a power command.
+ *
+ * @param line The line, holding one non-negative integer.
+ * @param exponent Receives the integer.
+ * @return `false` if the line holds anything else; otherwise, `true`.
+ */
+static bool parseExponent(std::string_view line, int64_t &exponent)
+{
+    const char *end = line.data() + line.size();
+    const char *cursor = endOfValue(scanNumber(skipSeparators(line.data(), end), end, exponent), end);
+    return cursor != nullptr && skipSeparators(cursor, end) == end && exponent >= 0;
 }
 
 /**
- * @brief Processes a single command with the given polynomials and optional evaluation point.
+ * @brief Processes a single command with the given polynomials and optional evaluation point(s), expression or exponent.
  *
  * This function executes the specified command by performing operations on the provided polynomials.
- * Supported commands include addition ('+'), subtraction ('-'), multiplication ('*'), getting the degree ('g'),
- * printing the polynomial ('p'), evaluating the polynomial ('a'), and getting the number of terms ('t').
+ * Supported commands include addition ('+'), subtraction ('-'), multiplication ('*'), the quotient ('/') and the
+ * remainder ('%') of a division, the greatest common divisor ('m'), raising to a power ('^') and to a power
+ * modulo a polynomial ('r'), getting the degree ('g'),
+ * printing the polynomial ('p'), evaluating the polynomial ('a'), evaluating it at a vector of points ('v'),
+ * batch-evaluating it at many points through a subproduct tree ('b'), evaluating a multi-operand expression ('e'),
+ * and getting the number of terms ('t').
+ *
+ * With `cacheSettings().enabled`, products are taken from `resultCache<T>()` when the same operands
+ * were multiplied before, and stored there otherwise.
  *
  * @param command The command character indicating the operation to perform.
  * @param poly1 Reference to the first `List` object representing the first polynomial.
  * @param poly2 Reference to the second `List` object representing the second polynomial.
- * @param x Optional float value used for evaluating the polynomial when the command is 'a'.
+ * @param x Optional value used for evaluating the polynomial when the command is 'a'.
+ * @param points Optional evaluation points used when the command is 'v' or 'b'.
+ * @param expression Optional parsed expression (with its operands populated) used when the command is 'e'.
+ * @param exponent Optional exponent used when the command is '^' or 'r' (the modulus of 'r' is the second polynomial).
+ * @param out The buffer receiving the results (the standard output by default). With
+ *            `OutputFormat::Pairs`, results are written as plain numbers and polynomials as
+ *            `coefficient degree` pairs, one line per result; with `OutputFormat::Binary`, as one
+ *            record of the binary form per result. In both, errors go to the error stream.
  */
-void processLine(char command, List &poly1, List &poly2, float x)
+template <typename T>
+void processLine(char command, BasicList<T> &poly1, BasicList<T> &poly2, const T *x, const std::vector<T> &points,
+                 BasicExpression<T> *expression, const int64_t *exponent, OutputBuffer &out)
 {
+    OutputFormat format = outputSettings().format;
+    bool pairs = format == OutputFormat::Pairs;
+    bool binary = format == OutputFormat::Binary;
+
+    // Prints a resulting polynomial after its label, as a line of pairs, or as a record
+    auto writeResult = [&](const char *label, const BasicList<T> &result)
+    {
+        PhaseTimer timer(Phase::Format);
+        recordResultTerms(result.size());
+        if (binary)
+        {
+            writeBinaryCommand(out, command, 1, 0);
+            writeBinaryPolynomial(out, result);
+        }
+        else if (pairs)
+        {
+            result.formatPairs(out);
+            out << '\n';
+        }
+        else
+        {
+            out << label;
+            result.showALL(true, out);
+        }
+    };
+
+    // Prints an integer result after its label and the polynomial, as a plain number, or as a record
+    auto writeCount = [&](const char *label, const BasicList<T> &poly, int64_t count)
+    {
+        PhaseTimer timer(Phase::Format);
+        if (binary)
+        {
+            writeBinaryCommand(out, command, 1, 0);
+            writeBinaryInteger(out, count);
+            return;
+        }
+        if (!pairs)
+        {
+            out << label;
+            poly.showALL(false, out);
+            out << " , é ";
+        }
+        out << count << '\n';
+    };
+
     switch (command)
     {
         case '+':
         {
-            List result = poly1 + poly2;
-            std::cout << "Resultado da soma dos polinômios: ";
-            result.showALL();
-            poly1 = List();
-            poly2 = List();
+            {
+                PhaseTimer timer(Phase::Compute);
+                poly1 += poly2;
+            }
+            writeResult("Resultado da soma dos polinômios: ", poly1);
+            poly1.reset();
+            poly2.reset();
             break;
         }
         case '-':
         {
-            List result = poly1 - poly2;
-            std::cout << "Resultado da subtração dos polinômios: ";
-            result.showALL();
-            poly1 = List();
-            poly2 = List();
+            {
+                PhaseTimer timer(Phase::Compute);
+                poly1 -= poly2;
+            }
+            writeResult("Resultado da subtração dos polinômios: ", poly1);
+            poly1.reset();
+            poly2.reset();
             break;
         }
         case '*':
         {
-            List result = poly1 * poly2;
-            std::cout << "Resultado da multiplicação dos polinômios: ";
-            result.showALL();
-            poly1 = List();
-            poly2 = List();
+            if ((int64_t)poly1.getDegree() + poly2.getDegree() > INT_MAX)
+            {
+                errorOutput() << "Erro: Grau do produto grande demais." << std::endl;
+                poly1.reset();
+                poly2.reset();
+                break;
+            }
+
+            // With the cache on, the product is looked up by the identities of its operands, in either order
+            std::shared_ptr<const BasicList<T>> result;
+            {
+                PhaseTimer timer(Phase::Compute);
+                if (cacheSettings().enabled)
+                {
+                    CacheOperand first = cacheOperand(poly1);
+                    CacheOperand second = cacheOperand(poly2);
+                    if (second < first)
+                        std::swap(first, second);
+
+                    BasicResultCache<T> &cache = resultCache<T>();
+                    result = cache.find(command, first, second);
+                    if (result == nullptr)
+                    {
+                        result = std::make_shared<const BasicList<T>>(poly1 * poly2);
+                        cache.insert(command, first, second, result);
+                    }
+                }
+                else
+                {
+                    result = std::make_shared<const BasicList<T>>(poly1 * poly2);
+                }
+            }
+            writeResult("Resultado da multiplicação dos polinômios: ", *result);
+            poly1.reset();
+            poly2.reset();
+            break;
+        }
+        case '/':
+        case '%':
+        {
+            BasicList<T> quotient, remainder;
+            bool divided;
+            {
+                PhaseTimer timer(Phase::Compute);
+                divided = command == '/' ? dividePolynomials(poly1, poly2, quotient, remainder)
+                                         : polynomialRemainder(poly1, poly2, remainder);
+            }
+            if (divided && command == '/')
+                writeResult("Resultado da divisão dos polinômios: ", quotient);
+            else if (divided)
+                writeResult("Resto da divisão dos polinômios: ", remainder);
+            else if (poly2.isEmpty())
+                errorOutput() << "Erro: Divisão por polinômio nulo." << std::endl;
+            else
+                errorOutput() << "Erro: Divisão não exata com coeficientes " << CoefficientTraits<T>::NAME << "." << std::endl;
+            poly1.reset();
+            poly2.reset();
+            break;
+        }
+        case 'm':
+        {
+            BasicList<T> gcd;
+            bool computed;
+            {
+                PhaseTimer timer(Phase::Compute);
+                computed = polynomialGcd(poly1, poly2, gcd);
+            }
+            if (computed)
+                writeResult("Máximo divisor comum dos polinômios: ", gcd);
+            else
+                errorOutput() << "Erro: Estouro de " << CoefficientTraits<T>::NAME << " no cálculo do máximo divisor comum." << std::endl;
+            poly1.reset();
+            poly2.reset();
+            break;
+        }
+        case '^':
+        case 'r':
+        {
+            if (exponent == nullptr || *exponent < 0)
+            {
+                errorOutput() << "Erro: Expoente inválido para potência." << std::endl;
+                poly1.reset();
+                poly2.reset();
+                break;
+            }
+
+            BasicList<T> power;
+            bool computed;
+            {
+                PhaseTimer timer(Phase::Compute);
+                if (command == '^')
+                    computed = polynomialPower(poly1, (uint64_t)*exponent, power);
+                else
+                    computed = polynomialPowerMod(poly1, (uint64_t)*exponent, poly2, power);
+            }
+            if (computed && command == '^')
+                writeResult("Resultado da potência do polinômio: ", power);
+            else if (computed)
+                writeResult("Resultado da potência modular do polinômio: ", power);
+            else if (command == '^')
+                errorOutput() << "Erro: Grau da potência grande demais." << std::endl;
+            else if (poly2.isEmpty())
+                errorOutput() << "Erro: Divisão por polinômio nulo." << std::endl;
+            else
+                errorOutput() << "Erro: Divisão não exata com coeficientes " << CoefficientTraits<T>::NAME << "." << std::endl;
+            poly1.reset();
+            poly2.reset();
+            break;
+        }
+        case 'e':
+        {
+            {
+                PhaseTimer timer(Phase::Compute);
+                expression->evaluateInto(poly1);
+            }
+            writeResult("Resultado da expressão: ", poly1);
+            poly1.reset();
+            expression->reset();
             break;
         }
         case 'g':
         {
-            std::cout << "O grau do polinômio: ";
-            poly1.showALL(false);
-            std::cout << " , é " << poly1.getDegree() << std::endl;
-            poly1 = List();
+            writeCount("O grau do polinômio: ", poly1, poly1.getDegree());
+            poly1.reset();
             break;
         }
         case 'p':
         {
-            std::cout << "Polinômio: ";
-            poly1.showALL();
-            poly1 = List();
+            writeResult("Polinômio: ", poly1);
+            poly1.reset();
             break;
         }
         case 'a':
         {
-            if (!std::isnan(x))
+            if (x != nullptr && CoefficientTraits<T>::isValid(*x))
+            {
+                // The readable form expands the expression while it evaluates it, so it counts as formatting
+                T value(0);
+                if (format != OutputFormat::Pretty)
+                {
+                    PhaseTimer timer(Phase::Compute);
+                    value = poly1.evaluateAt(*x);
+                }
+
+                PhaseTimer timer(Phase::Format);
+                recordResultTerms(1);
+                if (binary)
+                {
+                    writeBinaryCommand(out, command, 1, 0);
+                    writeBinaryValues(out, BinaryOperandKind::Value, &value, 1);
+                }
+                else if (pairs)
+                    out.writeExact(value) << '\n';
+                else
+                    poly1.evaluate(*x, out);
+            }
+            else
+            {
+                errorOutput() << "Erro: Valor de x inválido para avaliação." << std::endl;
+            }
+            poly1.reset();
+            break;
+        }
+        case 'v':
+        case 'b':
+        {
+            std::vector<T> values(points.size());
+            {
+                PhaseTimer timer(Phase::Compute);
+                if (command == 'b')
+                    multipointEvaluate(poly1, points.data(), values.data(), points.size());
+                else
+                    poly1.evaluateMany(points.data(), values.data(), points.size());
+            }
+
+            PhaseTimer timer(Phase::Format);
+            recordResultTerms((int64_t)values.size());
+            if (binary)
             {
-                poly1.evaluate(x); // Removed assignment since evaluate returns void
+                writeBinaryCommand(out, command, 2, 0);
+                writeBinaryValues(out, BinaryOperandKind::Points, points.data(), points.size());
+                writeBinaryValues(out, BinaryOperandKind::Points, values.data(), values.size());
             }
             else
             {
-                std::cerr << "Erro: Valor de x inválido para avaliação." << std::endl;
+                for (size_t i = 0; i < points.size(); i++)
+                {
+                    if (pairs)
+                    {
+                        out.writeExact(points[i]) << ' ';
+                        out.writeExact(values[i]) << '\n';
+                    }
+                    else
+                    {
+                        out << "p(";
+                        out.writeValue(points[i]) << ") = ";
+                        out.writeValue(values[i]) << '\n';
+                    }
+                }
             }
-            poly1 = List();
+            poly1.reset();
             break;
         }
         case 't':
         {
-            std::cout << "Número de termos do polinômio: ";
-            poly1.showALL(false);
-            std::cout << " , é " << poly1.size() << std::endl;
-            poly1 = List();
+            writeCount("Número de termos do polinômio: ", poly1, poly1.size());
+            poly1.reset();
             break;
         }
         default:
-            std::cout << "Erro: Comando inválido." << std::endl;
+            if (format != OutputFormat::Pretty)
+                errorOutput() << "Erro: Comando inválido." << std::endl;
+            else
+                out << "Erro: Comando inválido.\n";
     }
 }
 
+// Result of reading one command block
+enum class BlockStatus
+{
+    Ready,   // The block is complete and can run
+    Skipped, // The command line was invalid or its operands were rejected; reading goes on
+    Stop,    // The input ended in the middle of the block
+    End      // The input ended before the block
+};
+
+// Command of one block of the input with its operands, read by readBlock and run by executeBlock
+template <typename T>
+struct CommandBlock
+{
+    char command = '\0';
+    char symbol = '\0';
+    size_t line = 0;
+    BasicList<T> poly1;
+    BasicList<T> poly2;
+    T x = T(0);
+    int64_t exponent = 0;
+    std::vector<T> points;
+    std::string expressionText;
+    BasicExpression<T> expression;
+    CommandRecord record;
+
+    // Drops the operands of a block that was not run; the node pools of its lists are kept
+    void reset()
+    {
+        poly1.reset();
+        poly2.reset();
+        points.clear();
+        expression.reset();
+    }
+};
+
 /**
- * @brief Processes the entire file by reading commands and executing them.
- *
- * This function reads a file containing commands and polynomial data, processes each line,
- * and performs the corresponding operations on the polynomials.
+ * @brief Reads the next command line and its operand lines into a block.
  *
- * The file is expected to contain commands followed by the necessary polynomial data or evaluation points.
- *
- * @param filePath The path to the input file to be processed.
+ * @param reader The reader of the input.
+ * @param block Receives the command and its parsed operands.
+ * @return The status of the block; errors are printed as they are found. A block with an operand
+ *         line that holds nothing usable still reads all its lines, and is `Skipped`.
  */
-void processFile(const std::string &filePath)
+template <typename T>
+static BlockStatus readBlock(LineReader &reader, CommandBlock<T> &block)
 {
-    std::vector<std::string> lines = trimFileLines(filePath);
-    List poly1, poly2;
+    std::string_view line;
+    if (!reader.next(line))
+        return BlockStatus::End;
+
+    size_t start = reader.lineCount();
     char command = '\0';
-    size_t count = 0;
+    getCommand(line, &command);
+    if (command == '\0')
+    {
+        errorOutput() << "Erro: Comando inválido na linha " << start << ": " << line << std::endl;
+        return BlockStatus::Skipped;
+    }
 
-    while (count < lines.size())
+    block.command = command;
+    block.symbol = line[0];
+    block.line = start;
+
+    // Cleared by an operand line that holds nothing usable
+    bool valid = true;
+    auto finish = [&block, &valid]()
     {
-        std::string line = lines[count];
-        getCommand(line, &command);
+        if (valid)
+            return BlockStatus::Ready;
+        block.reset();
+        return BlockStatus::Skipped;
+    };
 
-        if (command == '\0')
+    switch (command)
+    {
+        case '+':
+        case '-':
+        case '*':
+        case '/':
+        case '%':
+        case 'm':
         {
-            std::cerr << "Erro: Comando inválido na linha " << count + 1 << ": " << line << std::endl;
-            count++;
-            continue;
+            if (!reader.next(line))
+            {
+                errorOutput() << "Erro: Linhas insuficientes para a operação '" << command << "' iniciando na linha " << start << std::endl;
+                return BlockStatus::Stop;
+            }
+            valid = populatePolynomial(line, block.poly1);
+            if (!reader.next(line))
+            {
+                errorOutput() << "Erro: Linhas insuficientes para a operação '" << command << "' iniciando na linha " << start << std::endl;
+                return BlockStatus::Stop;
+            }
+            valid = populatePolynomial(line, block.poly2) && valid;
+            return finish();
         }
-
-        switch (command)
+        case 'p':
+        case 'g':
+        case 't':
         {
-            case '+':
-            case '-':
-            case '*':
+            if (!reader.next(line))
             {
-                if (count + 2 >= lines.size())
-                {
-                    std::cerr << "Erro: Linhas insuficientes para a operação '" << command << "' iniciando na linha " << count + 1 << std::endl;
-                    return;
-                }
-                populatePolynomial(lines[++count], poly1);
-                populatePolynomial(lines[++count], poly2);
-                processLine(command, poly1, poly2); // Passing NaN as default
-                break;
+                errorOutput() << "Erro: Linhas insuficientes para o comando '" << command << "' iniciando na linha " << start << std::endl;
+                return BlockStatus::Stop;
             }
-            case 'p':
-            case 'g':
-            case 't':
+            valid = populatePolynomial(line, block.poly1);
+            return finish();
+        }
+        case 'a':
+        {
+            // The x line is kept until the polynomial line is known to exist
+            std::string xLine;
+            if (reader.next(line))
+                xLine = line;
+            if (xLine.empty() || !reader.next(line))
             {
-                if (count + 1 >= lines.size())
-                {
-                    std::cerr << "Erro: Linhas insuficientes para o comando '" << command << "' iniciando na linha " << count + 1 << std::endl;
-                    return;
-                }
-                populatePolynomial(lines[++count], poly1);
-                processLine(command, poly1, poly2); // Passing NaN as default
-                break;
+                errorOutput() << "Erro: Linhas insuficientes para o comando 'a' iniciando na linha " << start << std::endl;
+                return BlockStatus::Stop;
             }
-            case 'a':
+            try
             {
-                if (count + 2 >= lines.size())
-                {
-                    std::cerr << "Erro: Linhas insuficientes para o comando 'a' iniciando na linha " << count + 1 << std::endl;
-                    return;
-                }
-                float x;
-                try
+                block.x = CoefficientTraits<T>::parse(xLine);
+            }
+            catch (const std::exception &e)
+            {
+                errorOutput() << "Erro ao converter valor de x na linha " << start + 1 << std::endl;
+                return BlockStatus::Stop;
+            }
+            valid = populatePolynomial(line, block.poly1);
+            return finish();
+        }
+        case '^':
+        case 'r':
+        {
+            // The exponent line comes first, then the base and, for 'r', the modulus
+            if (!reader.next(line))
+            {
+                errorOutput() << "Erro: Linhas insuficientes para o comando '" << command << "' iniciando na linha " << start << std::endl;
+                return BlockStatus::Stop;
+            }
+            valid = parseExponent(line, block.exponent);
+            if (!valid)
+                errorOutput() << "Erro ao converter o expoente na linha " << start + 1 << std::endl;
+            if (!reader.next(line))
+            {
+                errorOutput() << "Erro: Linhas insuficientes para o comando '" << command << "' iniciando na linha " << start << std::endl;
+                return BlockStatus::Stop;
+            }
+            valid = populatePolynomial(line, block.poly1) && valid;
+            if (command == 'r')
+            {
+                if (!reader.next(line))
                 {
-                    x = std::stof(lines[++count]);
+                    errorOutput() << "Erro: Linhas insuficientes para o comando 'r' iniciando na linha " << start << std::endl;
+                    return BlockStatus::Stop;
                 }
-                catch (const std::exception &e)
+                valid = populatePolynomial(line, block.poly2) && valid;
+            }
+            return finish();
+        }
+        case 'v':
+        case 'b':
+        {
+            if (!reader.next(line))
+            {
+                errorOutput() << "Erro: Linhas insuficientes para o comando '" << command << "' iniciando na linha " << start << std::endl;
+                return BlockStatus::Stop;
+            }
+            valid = populatePoints(line, block.points);
+            if (!reader.next(line))
+            {
+                errorOutput() << "Erro: Linhas insuficientes para o comando '" << command << "' iniciando na linha " << start << std::endl;
+                return BlockStatus::Stop;
+            }
+            valid = populatePolynomial(line, block.poly1) && valid;
+            return finish();
+        }
+        case 'e':
+        {
+            if (!reader.next(line))
+            {
+                errorOutput() << "Erro: Linhas insuficientes para o comando 'e' iniciando na linha " << start << std::endl;
+                return BlockStatus::Stop;
+            }
+            block.expressionText = line;
+            if (!block.expression.parse(block.expressionText))
+                return BlockStatus::Skipped;
+            for (int i = 0; i < block.expression.operandCount(); i++)
+            {
+                if (!reader.next(line))
                 {
-                    std::cerr << "Erro ao converter valor de x na linha " << count + 1 << std::endl;
-                    return;
+                    errorOutput() << "Erro: Linhas insuficientes para os operandos da expressão iniciando na linha " << start + 1 << std::endl;
+                    return BlockStatus::Stop;
                 }
-                populatePolynomial(lines[++count], poly1);
-                processLine(command, poly1, poly2, x);
-                break;
+                valid = populatePolynomial(line, block.expression.operand(i)) && valid;
             }
-            default:
-                std::cout << "Erro: Comando inválido na linha " << count + 1 << ": " << line << std::endl;
+            return finish();
         }
-        count++;
+        default:
+            // Reported by executeBlock, in its place in the output
+            return BlockStatus::Ready;
     }
 }
+
+/**
+ * @brief Stores the packed terms of a Polynomial operand into a polynomial, as `populatePolynomial` stores a line.
+ *
+ * @param coefficients The stored coefficients, in place in the mapped file.
+ * @param degrees The degrees of the coefficients.
+ * @param count The number of terms.
+ * @param poly The polynomial receiving the terms.
+ */
+template <typename T>
+static void loadPolynomial(const typename BinaryCoefficient<T>::Stored *coefficients, const int32_t *degrees,
+                           size_t count, BasicList<T> &poly)
+{
+    static thread_local std::vector<std::pair<int, T>> terms;
+    terms.clear();
+    terms.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        terms.emplace_back(degrees[i], BinaryCoefficient<T>::load(coefficients[i]));
+
+    if (poly.isEmpty())
+    {
+        storeTerms(terms, poly);
+        return;
+    }
+
+    for (const std::pair<int, T> &term : terms)
+    {
+        poly.insert(term.second, term.first);
+    }
+}
+
+/**
+ * @brief Reads the next command record of a file in the binary form and its operands into a block.
+ *
+ * @param reader The reader of the mapped file, past its header.
+ * @param block Receives the command and its operands.
+ * @return The status of the block; errors are printed as they are found.
+ *
+ * Polynomial operands fill the first and the second polynomial in turn, or the operands of the
+ * expression of an `E` command, whose Text operand comes first.
+ */
+template <typename T>
+static BlockStatus readBlock(BinaryReader &reader, CommandBlock<T> &block)
+{
+    using Stored = typename BinaryCoefficient<T>::Stored;
+
+    if (reader.atEnd())
+        return BlockStatus::End;
+
+    const BinaryCommand *record = reader.take<BinaryCommand>(1);
+    if (record == nullptr)
+    {
+        errorOutput() << "Erro: Arquivo binário truncado." << std::endl;
+        return BlockStatus::Stop;
+    }
+
+    block.command = (char)std::tolower((unsigned char)record->command);
+    block.symbol = record->command;
+    block.line = record->line;
+
+    bool valid = true;
+    int polynomials = 0;
+    for (int i = 0; i < record->operandCount; i++)
+    {
+        const BinaryOperand *operand = reader.take<BinaryOperand>(1);
+        bool complete = operand != nullptr;
+        if (complete && operand->kind == BinaryOperandKind::Polynomial)
+        {
+            const Stored *coefficients = reader.take<Stored>(operand->count);
+            const int32_t *degrees = reader.take<int32_t>(operand->count);
+            complete = coefficients != nullptr && degrees != nullptr;
+
+            BasicList<T> *target = nullptr;
+            if (block.command == 'e')
+                target = valid && polynomials < block.expression.operandCount() ? &block.expression.operand(polynomials) : nullptr;
+            else
+                target = polynomials == 0 ? &block.poly1 : polynomials == 1 ? &block.poly2 : nullptr;
+            polynomials++;
+
+            if (complete && target != nullptr)
+                loadPolynomial(coefficients, degrees, operand->count, *target);
+        }
+        else if (complete && (operand->kind == BinaryOperandKind::Points || operand->kind == BinaryOperandKind::Value))
+        {
+            const Stored *values = reader.take<Stored>(operand->count);
+            complete = values != nullptr;
+            if (complete && operand->kind == BinaryOperandKind::Points)
+            {
+                block.points.resize(operand->count);
+                for (size_t j = 0; j < operand->count; j++)
+                    block.points[j] = BinaryCoefficient<T>::load(values[j]);
+            }
+            else if (complete && operand->count > 0)
+            {
+                block.x = BinaryCoefficient<T>::load(values[0]);
+            }
+        }
+        else if (complete && operand->kind == BinaryOperandKind::Integer)
+        {
+            const int64_t *values = reader.take<int64_t>(operand->count);
+            complete = values != nullptr;
+            if (complete && operand->count > 0)
+                block.exponent = values[0];
+        }
+        else if (complete && operand->kind == BinaryOperandKind::Text)
+        {
+            const char *text = reader.take<char>(operand->count);
+            complete = text != nullptr;
+            if (complete)
+            {
+                block.expressionText.assign(text, operand->count);
+                valid = block.expression.parse(block.expressionText);
+            }
+        }
+        else if (complete)
+        {
+            errorOutput() << "Erro: Operando binário desconhecido no comando da linha " << block.line << std::endl;
+            return BlockStatus::Stop;
+        }
+
+        if (!complete)
+        {
+            errorOutput() << "Erro: Arquivo binário truncado no comando da linha " << block.line << std::endl;
+            return BlockStatus::Stop;
+        }
+    }
+    return valid ? BlockStatus::Ready : BlockStatus::Skipped;
+}
+
+/**
+ * @brief Reads the next block with `readBlock`, timing it as the parse phase of the block's record.
+ */
+template <typename T, typename Reader>
+static BlockStatus readTimedBlock(Reader &reader, CommandBlock<T> &block)
+{
+    block.record.clear();
+    CommandScope scope(block.record);
+    PhaseTimer timer(Phase::Parse);
+    BlockStatus status = readBlock(reader, block);
+    block.record.command = block.command;
+    block.record.line = block.line;
+    return status;
+}
+
+/**
+ * @brief Dispatches a block to `processLine` with the operands its command takes.
+ */
+template <typename T>
+static void runBlock(CommandBlock<T> &block, OutputBuffer &out)
+{
+    switch (block.command)
+    {
+        case '+':
+        case '-':
+        case '*':
+        case '/':
+        case '%':
+        case 'm':
+        case 'p':
+        case 'g':
+        case 't':
+        case 'v':
+        case 'b':
+            processLine<T>(block.command, block.poly1, block.poly2, nullptr, block.points, nullptr, nullptr, out);
+            break;
+        case 'a':
+            processLine<T>(block.command, block.poly1, block.poly2, &block.x, block.points, nullptr, nullptr, out);
+            break;
+        case '^':
+        case 'r':
+            processLine<T>(block.command, block.poly1, block.poly2, nullptr, block.points, nullptr, &block.exponent, out);
+            break;
+        case 'e':
+            processLine<T>(block.command, block.poly1, block.poly2, nullptr, block.points, &block.expression, nullptr, out);
+            break;
+        default:
+            if (outputSettings().format != OutputFormat::Pretty)
+                errorOutput() << "Erro: Comando inválido na linha " << block.line << ": " << block.symbol << std::endl;
+            else
+                out << "Erro: Comando inválido na linha " << block.line << ": " << block.symbol << '\n';
+    }
+}
+
+/**
+ * @brief Runs a block read by `readBlock` and resets its operands.
+ *
+ * @param block The block to run.
+ * @param out The buffer receiving the results.
+ *
+ * A result too large for the memory, such as the dense quotient of a sparse division of huge
+ * degree, or whose degree does not fit in an int, such as a product inside an expression, fails
+ * with an error for its block only, and the following blocks still run.
+ */
+template <typename T>
+static void executeBlock(CommandBlock<T> &block, OutputBuffer &out)
+{
+    CommandScope scope(block.record);
+    try
+    {
+        runBlock(block, out);
+    }
+    catch (const std::bad_alloc &)
+    {
+        errorOutput() << "Erro: Memória insuficiente para o comando da linha " << block.line << "." << std::endl;
+        block.reset();
+    }
+    catch (const std::length_error &)
+    {
+        errorOutput() << "Erro: Memória insuficiente para o comando da linha " << block.line << "." << std::endl;
+        block.reset();
+    }
+    catch (const std::overflow_error &)
+    {
+        errorOutput() << "Erro: Grau do resultado grande demais no comando da linha " << block.line << "." << std::endl;
+        block.reset();
+    }
+}
+
+/**
+ * @brief Runs the blocks of the input on a thread pool and prints their results in input order.
+ *
+ * @param reader The reader of the input: a `LineReader`, or a `BinaryReader` for the binary form.
+ * @param jobs Number of worker threads.
+ * @param out The buffer receiving the results.
+ *
+ * The calling thread reads and parses the blocks and hands each one to the pool, where it runs
+ * into its own detached `OutputBuffer`. The buffers are printed in input order as soon as every earlier
+ * block is done, so the output is byte-for-byte the output of the sequential run. At most
+ * `4 * jobs` blocks are in flight, which keeps memory bounded as in the sequential run.
+ */
+template <typename T, typename Reader>
+static void processParallel(Reader &reader, int jobs, OutputBuffer &out)
+{
+    struct Pending
+    {
+        CommandBlock<T> block;
+        OutputBuffer output;
+        std::future<void> done;
+    };
+
+    ThreadPool pool(jobs);
+    std::deque<std::unique_ptr<Pending>> pending;
+    size_t window = 4 * (size_t)pool.size();
+
+    auto printFront = [&]()
+    {
+        pending.front()->done.get();
+        finishCommand(pending.front()->block.record);
+        out << pending.front()->output.view();
+        pending.pop_front();
+    };
+
+    while (true)
+    {
+        if (!reader.hasBufferedInput())
+            out.flush();
+
+        auto item = std::make_unique<Pending>();
+        BlockStatus status = readTimedBlock(reader, item->block);
+        if (status == BlockStatus::End || status == BlockStatus::Stop)
+            break;
+        if (status == BlockStatus::Skipped)
+            continue;
+
+        Pending *block = item.get();
+        block->done = pool.submit([block]() { executeBlock(block->block, block->output); });
+        pending.push_back(std::move(item));
+
+        while (!pending.empty() && (pending.size() >= window ||
+                                    pending.front()->done.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+            printFront();
+    }
+
+    while (!pending.empty())
+        printFront();
+    out.flush();
+}
+
+/**
+ * @brief Reads the blocks of the input one by one into a block and runs each as soon as it is read.
+ *
+ * @param reader The reader of the input: a `LineReader`, or a `BinaryReader` for the binary form.
+ * @param block The block the commands are read into, reused for each of them.
+ * @param out The buffer receiving the results.
+ * @return The status that ended the input: `End`, or `Stop` in the middle of a block.
+ */
+template <typename T, typename Reader>
+static BlockStatus processSequential(Reader &reader, CommandBlock<T> &block, OutputBuffer &out)
+{
+    if (outputSettings().format == OutputFormat::Binary)
+        writeBinaryHeader<T>(out);
+
+    while (true)
+    {
+        // Results are written out in large blocks, and before waiting for more input
+        if (!reader.hasBufferedInput())
+            out.flush();
+
+        BlockStatus status = readTimedBlock(reader, block);
+        if (status == BlockStatus::End || status == BlockStatus::Stop)
+        {
+            out.flush();
+            return status;
+        }
+        if (status == BlockStatus::Ready)
+        {
+            executeBlock(block, out);
+            finishCommand(block.record);
+        }
+    }
+}
+
+/**
+ * @brief Reads the blocks of the input one by one and runs each as soon as it is read.
+ *
+ * @param reader The reader of the input: a `LineReader`, or a `BinaryReader` for the binary form.
+ * @param jobs Number of command blocks run concurrently; above 1, see `processParallel`.
+ */
+template <typename T, typename Reader>
+static void processBlocks(Reader &reader, int jobs)
+{
+    if (jobs > 1)
+    {
+        if (outputSettings().format == OutputFormat::Binary)
+            writeBinaryHeader<T>(standardOutput());
+        processParallel<T>(reader, jobs, standardOutput());
+        return;
+    }
+
+    CommandBlock<T> block;
+    processSequential(reader, block, standardOutput());
+}
+
+/**
+ * @brief Maps a file in the binary form and checks that its header matches this build and the coefficient type.
+ *
+ * @param reader The reader of the mapped file.
+ * @param filePath The path to the file, for the error messages.
+ * @return `true` if the records of the file can be read; otherwise, `false`, with the reason printed.
+ */
+template <typename T>
+static bool checkBinaryHeader(const BinaryReader &reader, const std::string &filePath)
+{
+    const BinaryHeader *header = reader.isOpen() ? reader.header() : nullptr;
+    if (header == nullptr)
+    {
+        errorOutput() << "Erro: Não foi possível ler o arquivo binário '" << filePath << "'." << std::endl;
+        return false;
+    }
+    if (header->version != BINARY_VERSION || header->byteOrder != BINARY_BYTE_ORDER ||
+        header->coefficientSize != sizeof(typename BinaryCoefficient<T>::Stored))
+    {
+        errorOutput() << "Erro: Versão ou ordem de bytes do arquivo binário '" << filePath << "' não suportada." << std::endl;
+        return false;
+    }
+    if (header->type != (uint8_t)CoefficientTraits<T>::TYPE)
+    {
+        errorOutput() << "Erro: O arquivo binário '" << filePath << "' não tem coeficientes do tipo "
+                  << CoefficientTraits<T>::NAME << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Processes the entire file by streaming its lines and executing each command as soon as its operands are read.
+ *
+ * This function reads a file containing commands and polynomial data through a `LineReader`, so only
+ * the lines of the current command are in memory at any time, and performs the corresponding
+ * operations on the polynomials. The path "-" reads the commands from the standard input.
+ * A file in the binary form (see BinaryFormat.h) is mapped instead, and its records are run
+ * without any text parsing.
+ *
+ * The file is expected to contain commands followed by the necessary polynomial data or evaluation points.
+ *
+ * @param filePath The path to the input file to be processed.
+ * @param jobs Number of command blocks run concurrently; above 1, see `processParallel`.
+ */
+template <typename T>
+void processFile(const std::string &filePath, int jobs)
+{
+    SpanTimer span("processFile");
+    if (isBinaryFile(filePath))
+    {
+        BinaryReader reader(filePath);
+        if (!checkBinaryHeader<T>(reader, filePath))
+            exit(1);
+        processBlocks<T>(reader, jobs);
+        return;
+    }
+
+    LineReader reader(filePath);
+    if (!reader.isOpen())
+    {
+        errorOutput() << "Erro: Não foi possível abrir o arquivo '" << filePath << "' para leitura." << std::endl;
+        exit(1);
+    }
+    processBlocks<T>(reader, jobs);
+}
+
+/**
+ * @brief Runs the command blocks of one request of a client, up to the end of its frame or of the input.
+ *
+ * The blocks are read into a block kept by the calling thread, so the node pools of its lists stay
+ * allocated from one request to the next; a request that ends in the middle of a block drops it,
+ * as does one whose block throws, before the exception reaches the caller.
+ *
+ * @param reader The reader of the connection, with its frame end set (see `LineReader::setFrameEnd`).
+ * @param out The buffer receiving the results of the request.
+ */
+template <typename T>
+void processRequest(LineReader &reader, OutputBuffer &out)
+{
+    static thread_local CommandBlock<T> block;
+    try
+    {
+        if (processSequential(reader, block, out) == BlockStatus::Stop)
+            block.reset();
+    }
+    catch (...)
+    {
+        // The operands of the failed block must not leak into the next request
+        block.reset();
+        throw;
+    }
+}
+
+/**
+ * @brief Writes the operands of a block as the records of the binary form.
+ */
+template <typename T>
+static void writeBinaryBlock(const CommandBlock<T> &block, OutputBuffer &out)
+{
+    switch (block.command)
+    {
+        case '+':
+        case '-':
+        case '*':
+        case '/':
+        case '%':
+        case 'm':
+            writeBinaryCommand(out, block.symbol, 2, block.line);
+            writeBinaryPolynomial(out, block.poly1);
+            writeBinaryPolynomial(out, block.poly2);
+            break;
+        case 'p':
+        case 'g':
+        case 't':
+            writeBinaryCommand(out, block.symbol, 1, block.line);
+            writeBinaryPolynomial(out, block.poly1);
+            break;
+        case 'a':
+            writeBinaryCommand(out, block.symbol, 2, block.line);
+            writeBinaryValues(out, BinaryOperandKind::Value, &block.x, 1);
+            writeBinaryPolynomial(out, block.poly1);
+            break;
+        case '^':
+            writeBinaryCommand(out, block.symbol, 2, block.line);
+            writeBinaryInteger(out, block.exponent);
+            writeBinaryPolynomial(out, block.poly1);
+            break;
+        case 'r':
+            writeBinaryCommand(out, block.symbol, 3, block.line);
+            writeBinaryInteger(out, block.exponent);
+            writeBinaryPolynomial(out, block.poly1);
+            writeBinaryPolynomial(out, block.poly2);
+            break;
+        case 'v':
+        case 'b':
+            writeBinaryCommand(out, block.symbol, 2, block.line);
+            writeBinaryValues(out, BinaryOperandKind::Points, block.points.data(), block.points.size());
+            writeBinaryPolynomial(out, block.poly1);
+            break;
+        case 'e':
+            writeBinaryCommand(out, block.symbol, 1 + block.expression.operandCount(), block.line);
+            writeBinaryText(out, block.expressionText);
+            for (int i = 0; i < block.expression.operandCount(); i++)
+                writeBinaryPolynomial(out, block.expression.operand(i));
+            break;
+        default:
+            // Kept, so the error is reported in its place when the file is run
+            writeBinaryCommand(out, block.symbol, 0, block.line);
+    }
+}
+
+/**
+ * @brief Writes the operands of a block as the lines of the text form, with coefficients in their shortest exact form.
+ */
+template <typename T>
+static void writeTextBlock(const CommandBlock<T> &block, OutputBuffer &out)
+{
+    out << block.symbol << '\n';
+    switch (block.command)
+    {
+        case '+':
+        case '-':
+        case '*':
+        case '/':
+        case '%':
+        case 'm':
+            block.poly1.formatPairs(out);
+            out << '\n';
+            block.poly2.formatPairs(out);
+            out << '\n';
+            break;
+        case 'p':
+        case 'g':
+        case 't':
+            block.poly1.formatPairs(out);
+            out << '\n';
+            break;
+        case 'a':
+            out.writeExact(block.x) << '\n';
+            block.poly1.formatPairs(out);
+            out << '\n';
+            break;
+        case '^':
+        case 'r':
+            out << block.exponent << '\n';
+            block.poly1.formatPairs(out);
+            out << '\n';
+            if (block.command == 'r')
+            {
+                block.poly2.formatPairs(out);
+                out << '\n';
+            }
+            break;
+        case 'v':
+        case 'b':
+            for (size_t i = 0; i < block.points.size(); i++)
+            {
+                if (i > 0)
+                    out << ' ';
+                out.writeExact(block.points[i]);
+            }
+            out << '\n';
+            block.poly1.formatPairs(out);
+            out << '\n';
+            break;
+        case 'e':
+            out << block.expressionText << '\n';
+            for (int i = 0; i < block.expression.operandCount(); i++)
+            {
+                block.expression.operand(i).formatPairs(out);
+                out << '\n';
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Converts a command file between the text and the binary form.
+ *
+ * @param inputPath The file to convert; a file starting with BINARY_MAGIC is converted to text,
+ *                  any other (or "-", the standard input) to the binary form.
+ * @param outputPath The file receiving the converted commands; it is created or truncated.
+ *
+ * Each block is read as `processFile` reads it, with the same error messages, and written out
+ * instead of being run. Polynomials are written with their terms merged and in descending degree
+ * order, and text coefficients in their shortest exact form, so converting back and forth gives
+ * the same results as the original file.
+ */
+template <typename T>
+void convertFile(const std::string &inputPath, const std::string &outputPath)
+{
+    bool toText = isBinaryFile(inputPath);
+    std::unique_ptr<BinaryReader> binaryReader;
+    std::unique_ptr<LineReader> lineReader;
+    if (toText)
+    {
+        binaryReader = std::make_unique<BinaryReader>(inputPath);
+        if (!checkBinaryHeader<T>(*binaryReader, inputPath))
+            exit(1);
+    }
+    else
+    {
+        lineReader = std::make_unique<LineReader>(inputPath);
+        if (!lineReader->isOpen())
+        {
+            errorOutput() << "Erro: Não foi possível abrir o arquivo '" << inputPath << "' para leitura." << std::endl;
+            exit(1);
+        }
+    }
+
+    int descriptor = ::open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0)
+    {
+        errorOutput() << "Erro: Não foi possível abrir o arquivo '" << outputPath << "' para escrita." << std::endl;
+        exit(1);
+    }
+
+    {
+        OutputBuffer out(descriptor);
+        if (!toText)
+            writeBinaryHeader<T>(out);
+
+        CommandBlock<T> block;
+        while (true)
+        {
+            BlockStatus status = toText ? readBlock(*binaryReader, block) : readBlock(*lineReader, block);
+            if (status == BlockStatus::End || status == BlockStatus::Stop)
+                break;
+            if (status == BlockStatus::Skipped)
+                continue;
+
+            if (toText)
+                writeTextBlock(block, out);
+            else
+                writeBinaryBlock(block, out);
+
+            block.poly1.reset();
+            block.poly2.reset();
+            block.expression.reset();
+        }
+    }
+    ::close(descriptor);
+}
+
+/**
+ * @brief Reads the coefficient type stored in the header of a file in the binary form.
+ *
+ * @param filePath The path to the file.
+ * @param type Receives the stored type if the file is binary and the type is known.
+ * @return `true` if `type` was set; otherwise, `false` (a text file keeps the type of the command line).
+ */
+static bool binaryCoefficientType(const std::string &filePath, CoefficientType &type)
+{
+    if (!isBinaryFile(filePath))
+        return false;
+
+    BinaryReader reader(filePath);
+    const BinaryHeader *header = reader.isOpen() ? reader.header() : nullptr;
+    if (header == nullptr || header->type > (uint8_t)CoefficientType::Mod)
+        return false;
+    type = (CoefficientType)header->type;
+    return true;
+}
+
+/**
+ * @brief Processes the entire file with polynomials of the given coefficient type.
+ *
+ * @param filePath The path to the input file to be processed.
+ * @param type The coefficient type selected on the command line; a binary file is run with the type stored in it.
+ * @param jobs Number of command blocks run concurrently.
+ */
+void processFile(const std::string &filePath, CoefficientType type, int jobs)
+{
+    binaryCoefficientType(filePath, type);
+    switch (type)
+    {
+        case CoefficientType::Float:
+            processFile<float>(filePath, jobs);
+            break;
+        case CoefficientType::Double:
+            processFile<double>(filePath, jobs);
+            break;
+        case CoefficientType::Int64:
+            processFile<int64_t>(filePath, jobs);
+            break;
+        case CoefficientType::Mod:
+            processFile<ModInt>(filePath, jobs);
+            break;
+    }
+}
+
+/**
+ * @brief Converts a command file between the text and the binary form.
+ *
+ * @param inputPath The file to convert.
+ * @param outputPath The file receiving the converted commands.
+ * @param type The coefficient type of a text input; a binary input keeps the type stored in it.
+ */
+void convertFile(const std::string &inputPath, const std::string &outputPath, CoefficientType type)
+{
+    binaryCoefficientType(inputPath, type);
+    switch (type)
+    {
+        case CoefficientType::Float:
+            convertFile<float>(inputPath, outputPath);
+            break;
+        case CoefficientType::Double:
+            convertFile<double>(inputPath, outputPath);
+            break;
+        case CoefficientType::Int64:
+            convertFile<int64_t>(inputPath, outputPath);
+            break;
+        case CoefficientType::Mod:
+            convertFile<ModInt>(inputPath, outputPath);
+            break;
+    }
+}
+
+/**
+ * @brief Parses the name of an output format.
+ *
+ * @param name The name given on the command line: "pretty", "pairs" or "binary".
+ * @param format Receives the parsed format on success.
+ * @return `true` if the name is known; otherwise, `false`.
+ */
+bool parseOutputFormat(const std::string &name, OutputFormat &format)
+{
+    if (name == "pretty")
+        format = OutputFormat::Pretty;
+    else if (name == "pairs")
+        format = OutputFormat::Pairs;
+    else if (name == "binary")
+        format = OutputFormat::Binary;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Parses the name of a coefficient type.
+ *
+ * @param name The name given on the command line: "float", "double", "int64" or "mod".
+ * @param type Receives the parsed type on success.
+ * @return `true` if the name is known; otherwise, `false`.
+ */
+bool parseCoefficientType(const std::string &name, CoefficientType &type)
+{
+    if (name == CoefficientTraits<float>::NAME)
+        type = CoefficientType::Float;
+    else if (name == CoefficientTraits<double>::NAME)
+        type = CoefficientType::Double;
+    else if (name == CoefficientTraits<int64_t>::NAME)
+        type = CoefficientType::Int64;
+    else if (name == CoefficientTraits<ModInt>::NAME)
+        type = CoefficientType::Mod;
+    else
+        return false;
+    return true;
+}
+
+template bool populatePolynomial(std::string_view line, BasicList<float> &poly);
+template bool populatePolynomial(std::string_view line, BasicList<double> &poly);
+template bool populatePolynomial(std::string_view line, BasicList<int64_t> &poly);
+template bool populatePolynomial(std::string_view line, BasicList<ModInt> &poly);
+
+template size_t parseTerms(std::string_view line, std::vector<std::pair<int, float>> &terms);
+template size_t parseTerms(std::string_view line, std::vector<std::pair<int, double>> &terms);
+template size_t parseTerms(std::string_view line, std::vector<std::pair<int, int64_t>> &terms);
+template size_t parseTerms(std::string_view line, std::vector<std::pair<int, ModInt>> &terms);
+
+template bool populatePoints(std::string_view line, std::vector<float> &points);
+template bool populatePoints(std::string_view line, std::vector<double> &points);
+template bool populatePoints(std::string_view line, std::vector<int64_t> &points);
+template bool populatePoints(std::string_view line, std::vector<ModInt> &points);
+
+template void processLine(char command, BasicList<float> &poly1, BasicList<float> &poly2, const float *x,
+                          const std::vector<float> &points, BasicExpression<float> *expression, const int64_t *exponent,
+                          OutputBuffer &out);
+template void processLine(char command, BasicList<double> &poly1, BasicList<double> &poly2, const double *x,
+                          const std::vector<double> &points, BasicExpression<double> *expression, const int64_t *exponent,
+                          OutputBuffer &out);
+template void processLine(char command, BasicList<int64_t> &poly1, BasicList<int64_t> &poly2, const int64_t *x,
+                          const std::vector<int64_t> &points, BasicExpression<int64_t> *expression, const int64_t *exponent,
+                          OutputBuffer &out);
+template void processLine(char command, BasicList<ModInt> &poly1, BasicList<ModInt> &poly2, const ModInt *x,
+                          const std::vector<ModInt> &points, BasicExpression<ModInt> *expression, const int64_t *exponent,
+                          OutputBuffer &out);
+
+template void processFile<float>(const std::string &filePath, int jobs);
+template void processFile<double>(const std::string &filePath, int jobs);
+template void processFile<int64_t>(const std::string &filePath, int jobs);
+template void processFile<ModInt>(const std::string &filePath, int jobs);
+
+template void processRequest<float>(LineReader &reader, OutputBuffer &out);
+template void processRequest<double>(LineReader &reader, OutputBuffer &out);
+template void processRequest<int64_t>(LineReader &reader, OutputBuffer &out);
+template void processRequest<ModInt>(LineReader &reader, OutputBuffer &out);
+
+template void convertFile<float>(const std::string &inputPath, const std::string &outputPath);
+template void convertFile<double>(const std::string &inputPath, const std::string &outputPath);
+template void convertFile<int64_t>(const std::string &inputPath, const std::string &outputPath);
+template void convertFile<ModInt>(const std::string &inputPath, const std::string &outputPath);
@@ -0,0 +1,368 @@
+#include "../include/Instrumentation.h"
+#include "../include/NodePool.h"
+#include "../include/OutputBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unistd.h>
+
+/**
+ * Instrumentation of the command blocks.
+ *
+ * A block gets a `CommandRecord` that is made current on the thread reading it, and then on the
+ * thread running it, through `CommandScope`. `PhaseTimer`s placed around the parsing, the List
+ * operators and the formatting add their time and node allocations to the current record; with the
+ * instrumentation disabled no record is current, and a timer costs one thread-local load. A finished
+ * record goes to `finishCommand`, which adds it to the per-command statistics (a log2 latency
+ * histogram and totals) and streams its phases to the trace file, so memory use does not grow with
+ * the number of commands.
+ */
+
+// Buckets of the latency histograms: bucket b counts latencies in [2^b, 2^(b+1)) nanoseconds
+static constexpr int HISTOGRAM_BUCKETS = 48;
+
+struct CommandStats
+{
+    uint64_t count = 0;
+    int64_t phaseTime[PHASE_COUNT] = {};
+    uint64_t nodes = 0;
+    int64_t resultTerms = 0;
+    int64_t maxLatency = 0;
+    uint64_t histogram[HISTOGRAM_BUCKETS] = {};
+};
+
+static const char *PHASE_NAMES[PHASE_COUNT] = {"parse", "compute", "format"};
+
+// Statistics per command character, and the trace file; guarded by `instrumentationMutex`
+static std::mutex instrumentationMutex;
+static CommandStats commandStats[256];
+static std::unique_ptr<OutputBuffer> trace;
+static int traceDescriptor = -1;
+static bool firstEvent = true;
+
+// Record the phases timed on this thread are added to, if any
+static thread_local CommandRecord *activeRecord = nullptr;
+
+/**
+ * @brief Returns the settings of the instrumentation.
+ *
+ * @return Reference to the process-wide InstrumentationSettings object, set from the command line.
+ */
+InstrumentationSettings &instrumentationSettings()
+{
+    static InstrumentationSettings settings;
+    return settings;
+}
+
+/**
+ * @brief Returns the nanoseconds elapsed since the first call, on a monotonic clock.
+ */
+static int64_t now()
+{
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+/**
+ * @brief Returns a small number identifying the calling thread in the trace (1 for the first thread seen).
+ */
+static int threadNumber()
+{
+    static std::atomic<int> threads{0};
+    static thread_local int number = ++threads;
+    return number;
+}
+
+/**
+ * @brief Makes a record current on the calling thread, if the instrumentation is enabled.
+ *
+ * @param record The record of the block being read or run.
+ */
+CommandScope::CommandScope(CommandRecord &record) : previous(activeRecord)
+{
+    if (instrumentationSettings().enabled())
+        activeRecord = &record;
+}
+
+/**
+ * @brief Destructor that makes the previous record current again.
+ */
+CommandScope::~CommandScope()
+{
+    activeRecord = previous;
+}
+
+/**
+ * @brief Starts timing a phase of the current record; does nothing if there is none.
+ *
+ * @param phase The phase the lifetime of the timer is added to.
+ */
+PhaseTimer::PhaseTimer(Phase phase) : record(activeRecord), phase(phase), start(0), nodes(0)
+{
+    if (record == nullptr)
+        return;
+    start = now();
+    nodes = NodePool::threadNodeCount();
+}
+
+/**
+ * @brief Destructor that adds the elapsed time and the nodes created meanwhile to the phase.
+ */
+PhaseTimer::~PhaseTimer()
+{
+    if (record == nullptr)
+        return;
+
+    PhaseRecord &entry = record->phases[(int)phase];
+    if (entry.start < 0)
+    {
+        entry.start = start;
+        entry.thread = threadNumber();
+    }
+    entry.duration += now() - start;
+    entry.nodes += NodePool::threadNodeCount() - nodes;
+}
+
+/**
+ * @brief Writes a number of nanoseconds as microseconds with three decimals, the unit of the trace format.
+ */
+static void writeMicroseconds(OutputBuffer &out, int64_t nanoseconds)
+{
+    int64_t fraction = nanoseconds % 1000;
+    out << nanoseconds / 1000 << '.' << (char)('0' + fraction / 100) << (char)('0' + fraction / 10 % 10) << (char)('0' + fraction % 10);
+}
+
+/**
+ * @brief Writes the beginning of a complete ("X") trace event, up to its arguments.
+ *
+ * Must be called with `instrumentationMutex` held.
+ */
+static void beginEvent(std::string_view name, char command, const char *category, int64_t start, int64_t duration, int thread)
+{
+    OutputBuffer &out = *trace;
+    out << (firstEvent ? "\n" : ",\n") << "{\"name\": \"";
+    if (command != '\0')
+    {
+        // The command is any single character of the input; JSON needs some of them escaped
+        if (command == '"' || command == '\\')
+            out << '\\' << command;
+        else if ((unsigned char)command < 0x20 || (unsigned char)command >= 0x80)
+            out << "\\u00" << "0123456789abcdef"[(unsigned char)command >> 4] << "0123456789abcdef"[command & 15];
+        else
+            out << command;
+        out << ' ';
+    }
+    out << name << "\", \"cat\": \"" << category << "\", \"ph\": \"X\", \"ts\": ";
+    writeMicroseconds(out, start);
+    out << ", \"dur\": ";
+    writeMicroseconds(out, duration);
+    out << ", \"pid\": 1, \"tid\": " << thread;
+    firstEvent = false;
+}
+
+/**
+ * @brief Starts timing a span of the trace; does nothing without a trace file.
+ *
+ * @param name The name of the span in the trace.
+ */
+SpanTimer::SpanTimer(const char *name) : name(name), start(trace != nullptr ? now() : -1) {}
+
+/**
+ * @brief Destructor that writes the span to the trace.
+ */
+SpanTimer::~SpanTimer()
+{
+    if (start < 0)
+        return;
+
+    int64_t end = now();
+    std::lock_guard<std::mutex> lock(instrumentationMutex);
+    if (trace == nullptr)
+        return;
+    beginEvent(name, '\0', "run", start, end - start, threadNumber());
+    *trace << '}';
+}
+
+/**
+ * @brief Sets the number of terms of the result of the block being run on the calling thread.
+ *
+ * @param terms The number of terms of the resulting polynomial (or of values for `V` and `B`).
+ */
+void recordResultTerms(int64_t terms)
+{
+    if (activeRecord != nullptr)
+        activeRecord->resultTerms = terms;
+}
+
+/**
+ * @brief Adds a finished block to the statistics of its command and writes its phases to the trace.
+ *
+ * @param record The record of the block, after it has been run.
+ *
+ * Safe to call from any thread; does nothing while the instrumentation is disabled.
+ */
+void finishCommand(const CommandRecord &record)
+{
+    if (!instrumentationSettings().enabled())
+        return;
+
+    std::lock_guard<std::mutex> lock(instrumentationMutex);
+
+    CommandStats &stats = commandStats[(unsigned char)record.command];
+    int64_t latency = 0;
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        stats.phaseTime[phase] += record.phases[phase].duration;
+        stats.nodes += record.phases[phase].nodes;
+        latency += record.phases[phase].duration;
+    }
+    int bucket = 0;
+    while (bucket + 1 < HISTOGRAM_BUCKETS && (int64_t(1) << (bucket + 1)) <= latency)
+        bucket++;
+    stats.histogram[bucket]++;
+    stats.count++;
+    stats.resultTerms += record.resultTerms;
+    if (latency > stats.maxLatency)
+        stats.maxLatency = latency;
+
+    if (trace == nullptr)
+        return;
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        const PhaseRecord &entry = record.phases[phase];
+        if (entry.start < 0)
+            continue;
+        beginEvent(PHASE_NAMES[phase], record.command, PHASE_NAMES[phase], entry.start, entry.duration, entry.thread);
+        *trace << ", \"args\": {\"line\": " << record.line << ", \"nodes\": " << entry.nodes;
+        if (phase == (int)Phase::Format)
+            *trace << ", \"terms\": " << record.resultTerms;
+        *trace << "}}";
+    }
+}
+
+/**
+ * @brief Opens the trace file, if one was asked for, and starts the clock.
+ *
+ * @return `false` if the trace file cannot be created (with the reason printed); otherwise, `true`.
+ */
+bool startInstrumentation()
+{
+    now();
+    const InstrumentationSettings &settings = instrumentationSettings();
+    if (settings.tracePath.empty())
+        return true;
+
+    traceDescriptor = ::open(settings.tracePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (traceDescriptor < 0)
+    {
+        std::cerr << "Erro: Não foi possível abrir o arquivo '" << settings.tracePath << "' para escrita." << std::endl;
+        return false;
+    }
+    trace = std::make_unique<OutputBuffer>(traceDescriptor);
+    *trace << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    return true;
+}
+
+/**
+ * @brief Writes a duration with a unit that keeps it short, e.g. "850 ns", "12.35 µs" or "4.20 ms".
+ */
+static void writeDuration(OutputBuffer &out, int64_t nanoseconds)
+{
+    if (nanoseconds < 1000)
+        out << nanoseconds << " ns";
+    else if (nanoseconds < 1000000)
+        out.writeCoefficient(nanoseconds / 1e3) << " µs";
+    else if (nanoseconds < 1000000000)
+        out.writeCoefficient(nanoseconds / 1e6) << " ms";
+    else
+        out.writeCoefficient(nanoseconds / 1e9) << " s";
+}
+
+/**
+ * @brief Writes the summary of one command: totals, latency percentiles and the histogram.
+ */
+static void writeSummary(OutputBuffer &out, char command, const CommandStats &stats)
+{
+    static const char *PHASE_LABELS[PHASE_COUNT] = {"análise", "cálculo", "formatação"};
+
+    out << "Comando '" << command << "': " << stats.count << (stats.count == 1 ? " execução" : " execuções");
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        out << (phase == 0 ? "; " : ", ") << PHASE_LABELS[phase] << ' ';
+        writeDuration(out, stats.phaseTime[phase]);
+    }
+    out << "; " << stats.nodes << " nós alocados; " << stats.resultTerms << " termos nos resultados\n";
+
+    // Percentiles are the upper bounds of the buckets they fall in
+    int first = HISTOGRAM_BUCKETS, last = 0;
+    uint64_t highest = 0;
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+    {
+        if (stats.histogram[bucket] == 0)
+            continue;
+        first = std::min(first, bucket);
+        last = bucket;
+        highest = std::max(highest, stats.histogram[bucket]);
+    }
+
+    out << "  Latência:";
+    const double PERCENTILES[] = {0.5, 0.9, 0.99};
+    const char *PERCENTILE_LABELS[] = {" p50 ≤ ", ", p90 ≤ ", ", p99 ≤ "};
+    for (int i = 0; i < 3; i++)
+    {
+        uint64_t target = (uint64_t)(PERCENTILES[i] * (double)stats.count + 0.999999);
+        uint64_t seen = 0;
+        int bucket = 0;
+        while (bucket < HISTOGRAM_BUCKETS - 1 && (seen += stats.histogram[bucket]) < target)
+            bucket++;
+        out << PERCENTILE_LABELS[i];
+        writeDuration(out, std::min(int64_t(1) << (bucket + 1), stats.maxLatency));
+    }
+    out << ", máxima ";
+    writeDuration(out, stats.maxLatency);
+    out << '\n';
+
+    for (int bucket = first; bucket <= last; bucket++)
+    {
+        out << "    ";
+        writeDuration(out, bucket == 0 ? 0 : int64_t(1) << bucket);
+        out << " a ";
+        writeDuration(out, int64_t(1) << (bucket + 1));
+        out << "\t|";
+        int width = (int)(40 * stats.histogram[bucket] / highest);
+        for (int i = 0; i < width; i++)
+            out << '#';
+        out << ' ' << stats.histogram[bucket] << '\n';
+    }
+}
+
+/**
+ * @brief Prints the per-command summary (with `--stats`) to the error stream and completes the trace file.
+ */
+void finishInstrumentation()
+{
+    std::lock_guard<std::mutex> lock(instrumentationMutex);
+
+    if (instrumentationSettings().stats)
+    {
+        OutputBuffer summary(STDERR_FILENO);
+        summary << "Estatísticas por comando (latência = análise + cálculo + formatação de cada bloco):\n";
+        for (int command = 0; command < 256; command++)
+        {
+            if (commandStats[command].count > 0)
+                writeSummary(summary, (char)command, commandStats[command]);
+        }
+    }
+
+    if (trace != nullptr)
+    {
+        *trace << "\n]}\n";
+        trace.reset();
+        ::close(traceDescriptor);
+        traceDescriptor = -1;
+    }
+}
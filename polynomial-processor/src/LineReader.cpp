@@ -0,0 +1,203 @@
+#include "../include/LineReader.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @class LineReader
+ * @brief Reads the trimmed, non-empty lines of a file or pipe through a fixed-size buffer.
+ *
+ * Input is read in blocks of `BUFFER_SIZE` bytes with `read(2)`, and every line is handed out as a
+ * view into the buffer, without copying it. Memory use therefore stays constant however large the
+ * input is; the buffer only grows when a single line does not fit in it. A partial read (from a pipe
+ * or a terminal) is used as soon as it arrives, so lines can be processed while the input is still
+ * being written.
+ */
+
+/**
+ * @brief Checks whether a character is whitespace in the sense of `trim`.
+ */
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+/**
+ * @brief Opens a file for reading; the path "-" reads the standard input.
+ *
+ * @param path The path to the file to be read.
+ *
+ * Use `isOpen` to check whether the file could be opened.
+ */
+LineReader::LineReader(const std::string &path)
+    : descriptor(-1), ownsDescriptor(false), endOfInput(false), buffer(BUFFER_SIZE), begin(0), end(0), lines(0), frameEnded(false)
+{
+    if (path == "-")
+    {
+        descriptor = STDIN_FILENO;
+        return;
+    }
+
+    descriptor = ::open(path.c_str(), O_RDONLY);
+    ownsDescriptor = descriptor >= 0;
+#ifdef POSIX_FADV_SEQUENTIAL
+    if (ownsDescriptor)
+        posix_fadvise(descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+/**
+ * @brief Reads from a descriptor that is already open; it is not closed by the reader.
+ *
+ * @param descriptor The file descriptor to read from.
+ */
+LineReader::LineReader(int descriptor)
+    : descriptor(descriptor), ownsDescriptor(false), endOfInput(false), buffer(BUFFER_SIZE), begin(0), end(0), lines(0), frameEnded(false) {}
+
+/**
+ * @brief Destructor that closes the file opened by the reader.
+ */
+LineReader::~LineReader()
+{
+    if (ownsDescriptor)
+        ::close(descriptor);
+}
+
+/**
+ * @brief Checks whether the input could be opened.
+ *
+ * @return `true` if the reader has a valid descriptor; otherwise, `false`.
+ */
+bool LineReader::isOpen() const
+{
+    return descriptor >= 0;
+}
+
+/**
+ * @brief Returns the next trimmed, non-empty line.
+ *
+ * @param line Receives a view of the line, valid until the next call.
+ * @return `true` if a line was read; `false` at the end of the input, or at the end of the current frame.
+ */
+bool LineReader::next(std::string_view &line)
+{
+    if (frameEnded)
+        return false;
+
+    while (true)
+    {
+        const char *start = buffer.data() + begin;
+        const char *newline = static_cast<const char *>(std::memchr(start, '\n', end - begin));
+        const char *stop;
+        if (newline != nullptr)
+        {
+            stop = newline;
+            begin = newline + 1 - buffer.data();
+        }
+        else if (endOfInput || !refill())
+        {
+            if (begin == end)
+                return false;
+            start = buffer.data() + begin;
+            stop = buffer.data() + end;
+            begin = end;
+        }
+        else
+        {
+            continue;
+        }
+
+        while (start < stop && isSpace(*start))
+            start++;
+        while (stop > start && isSpace(stop[-1]))
+            stop--;
+        if (start != stop)
+        {
+            line = std::string_view(start, stop - start);
+            if (!frameEnd.empty() && line == frameEnd)
+            {
+                frameEnded = true;
+                return false;
+            }
+            lines++;
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of lines handed out so far, which is the number of the last one.
+ */
+std::size_t LineReader::lineCount() const
+{
+    return lines;
+}
+
+/**
+ * @brief Checks whether input is already buffered, so the next line may not need a read (which could block).
+ */
+bool LineReader::hasBufferedInput() const
+{
+    return begin != end;
+}
+
+/**
+ * @brief Splits the input into frames, such as the requests of a client, that each end at a given line.
+ *
+ * @param line The trimmed line that ends a frame; it is not handed out. An empty line turns framing off.
+ */
+void LineReader::setFrameEnd(const std::string &line)
+{
+    frameEnd = line;
+}
+
+/**
+ * @brief Checks whether `next` stopped at the end of a frame, rather than at the end of the input.
+ */
+bool LineReader::atFrameEnd() const
+{
+    return frameEnded;
+}
+
+/**
+ * @brief Starts reading the next frame; line numbers count again from its first line.
+ */
+void LineReader::nextFrame()
+{
+    frameEnded = false;
+    lines = 0;
+}
+
+/**
+ * @brief Moves the unread bytes to the front of the buffer and reads more input after them.
+ *
+ * @return `true` if more bytes were read; `false` at the end of the input or on a read error.
+ *
+ * The buffer doubles when it is full of a single unfinished line.
+ */
+bool LineReader::refill()
+{
+    if (begin > 0)
+    {
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    if (end == buffer.size())
+        buffer.resize(buffer.size() * 2);
+
+    ssize_t count;
+    do
+    {
+        count = ::read(descriptor, buffer.data() + end, buffer.size() - end);
+    } while (count < 0 && errno == EINTR);
+
+    if (count <= 0)
+    {
+        endOfInput = true;
+        return false;
+    }
+    end += count;
+    return true;
+}
@@ -1,27 +1,74 @@
 #include "../include/List.h"
+#include "../include/Multiplication.h"
 #include <iostream>
 #include <string>
+#include <charconv>
 #include <cmath>
-#include <map>
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
 
 /**
- * @class List
+ * @class BasicList
  * @brief Represents a polynomial as a singly linked list.
  *
- * The List class manages a polynomial where each node contains a coefficient and degree.
+ * The List class manages a polynomial where each node contains a coefficient and degree. It is a
+ * template over the coefficient type (see `CoefficientTraits`); `List` is the float instantiation.
  * The list is maintained in descending order of degrees to facilitate polynomial operations
  * such as addition, subtraction, and multiplication.
+ *
+ * A list whose terms fill most of the range up to its degree switches to dense storage: the
+ * coefficients move to a DensePolynomial and the vectorized kernels are used. The choice follows
+ * `storageSettings()` and is revisited after every change, with hysteresis between `denseRatio`
+ * and `sparseRatio`. It is invisible to callers: with dense storage, `getHead`, `search` and
+ * `getNext` walk a read-only node view that is rebuilt on demand and invalidated by any change.
  */
 
+/**
+ * @brief Returns the settings shared by every list.
+ *
+ * @return Reference to the process-wide StorageSettings object, which may be tuned at startup.
+ */
+StorageSettings &storageSettings()
+{
+    static StorageSettings settings;
+    return settings;
+}
+
 /**
  * @brief Default constructor that initializes an empty polynomial list.
  *
  * Initializes the head and tail pointers to nullptr and sets the list size to zero.
  */
-List::List()
-    : head(nullptr), tail(nullptr), listSize(0) {}
+template <typename T>
+BasicList<T>::BasicList()
+    : head(nullptr), tail(nullptr), listSize(0), denseStorage(false), viewValid(false) {}
+
+/**
+ * @brief Builds a polynomial from a dense coefficient array.
+ *
+ * @param poly The DensePolynomial object to copy.
+ *
+ * The list starts with dense storage and switches to linked storage if it is too sparse.
+ */
+template <typename T>
+BasicList<T>::BasicList(const BasicDensePolynomial<T> &poly)
+    : BasicList(BasicDensePolynomial<T>(poly)) {}
+
+/**
+ * @brief Builds a polynomial by taking over a dense coefficient array.
+ *
+ * @param poly The DensePolynomial object to move from.
+ */
+template <typename T>
+BasicList<T>::BasicList(BasicDensePolynomial<T> &&poly)
+    : head(nullptr), tail(nullptr), listSize(poly.size()), dense(std::move(poly)), denseStorage(true),
+      viewValid(false)
+{
+    adaptStorage();
+}
 
 /**
  * @brief Copy constructor that creates a deep copy of another List.
@@ -30,22 +77,39 @@ List::List()
  *
  * Initializes the new list by copying nodes from the `other` list.
  */
-List::List(const List &other)
-    : head(nullptr), tail(nullptr), listSize(0)
+template <typename T>
+BasicList<T>::BasicList(const BasicList &other)
+    : head(nullptr), tail(nullptr), listSize(0), denseStorage(false), viewValid(false)
 {
     copyFrom(other);
 }
 
 /**
- * @brief Destructor that cleans up all dynamically allocated nodes in the list.
+ * @brief Move constructor that takes over the nodes of another List.
+ *
+ * @param other The List object to move from; it is left empty.
  *
- * Calls the `clear` method to delete all nodes and reset pointers.
+ * No node is copied: the pool holding them (or the dense array) changes owner.
  */
-List::~List()
+template <typename T>
+BasicList<T>::BasicList(BasicList &&other) noexcept
+    : head(other.head), tail(other.tail), listSize(other.listSize), pool(std::move(other.pool)),
+      dense(std::move(other.dense)), denseStorage(other.denseStorage), viewValid(other.viewValid)
 {
-    clear();
+    other.head = other.tail = nullptr;
+    other.listSize = 0;
+    other.denseStorage = false;
+    other.viewValid = false;
 }
 
+/**
+ * @brief Destructor that cleans up all dynamically allocated nodes in the list.
+ *
+ * The nodes live in the list's pool, which frees them in bulk when it is destroyed.
+ */
+template <typename T>
+BasicList<T>::~BasicList() {}
+
 /**
  * @brief Copy assignment operator that assigns one List to another.
  *
@@ -55,7 +119,8 @@ List::~List()
  * Performs a deep copy of the `other` list into the current list.
  * Handles self-assignment by checking if the current object is the same as `other`.
  */
-List &List::operator=(const List &other)
+template <typename T>
+BasicList<T> &BasicList<T>::operator=(const BasicList &other)
 {
     if (this == &other)
         return *this;
@@ -65,6 +130,35 @@ List &List::operator=(const List &other)
     return *this;
 }
 
+/**
+ * @brief Move assignment operator that takes over the nodes of another List.
+ *
+ * @param other The List object to move from; it is left empty.
+ * @return Reference to the assigned List object.
+ *
+ * The current nodes are released in bulk and no node of `other` is copied.
+ */
+template <typename T>
+BasicList<T> &BasicList<T>::operator=(BasicList &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    pool = std::move(other.pool);
+    dense = std::move(other.dense);
+    head = other.head;
+    tail = other.tail;
+    listSize = other.listSize;
+    denseStorage = other.denseStorage;
+    viewValid = other.viewValid;
+
+    other.head = other.tail = nullptr;
+    other.listSize = 0;
+    other.denseStorage = false;
+    other.viewValid = false;
+    return *this;
+}
+
 /**
  * @brief Inserts a term into the list in sorted order.
  *
@@ -76,30 +170,50 @@ List &List::operator=(const List &other)
  *
  * @note Degrees must be non-negative integers. Terms with a zero coefficient are not inserted.
  */
-void List::insert(float coefficient, int degree)
+template <typename T>
+void BasicList<T>::insert(T coefficient, int degree)
 {
-    if (coefficient == 0.0f)
+    if (coefficient == T(0))
         return;
 
     if (degree < 0)
     {
-        std::cerr << "O grau deve ser um número inteiro não negativo.\n";
+        errorOutput() << "O grau deve ser um número inteiro não negativo.\n";
         return;
     }
 
+    if (denseStorage)
+    {
+        // A term far above the current degree would leave the array mostly empty
+        if (degree > dense.getDegree() && listSize + 1 < storageSettings().sparseRatio * (degree + 1.0f))
+        {
+            toSparse();
+        }
+        else
+        {
+            T previous = dense.getCoefficient(degree);
+            T updated = previous + coefficient;
+            dense.setCoefficient(degree, updated);
+            listSize += (previous == T(0)) - (updated == T(0));
+            invalidateView();
+            adaptStorage();
+            return;
+        }
+    }
+
     // Check if degree already exists and update coefficient if it does
     Node *existingNode = search(degree);
     if (existingNode != nullptr)
     {
         existingNode->coefficient += coefficient;
-        if (existingNode->coefficient == 0.0f)
+        if (existingNode->coefficient == T(0))
         {
             remove(degree);
         }
         return;
     }
 
-    Node *newNode = new Node(coefficient, degree);
+    Node *newNode = pool.create(coefficient, degree);
 
     // Insert in descending order of degrees
     if (isEmpty() || head->degree < degree)
@@ -123,6 +237,49 @@ void List::insert(float coefficient, int degree)
     }
 
     listSize++;
+    adaptStorage();
+}
+
+/**
+ * @brief Appends a term after the tail of the list.
+ *
+ * @param coefficient The coefficient of the term to append.
+ * @param degree The degree of the term to append.
+ *
+ * The caller must guarantee that `degree` is lower than the degree of the current tail,
+ * so the descending order is preserved without searching the list.
+ */
+template <typename T>
+void BasicList<T>::append(T coefficient, int degree)
+{
+    if (denseStorage)
+    {
+        dense.setCoefficient(degree, coefficient);
+        listSize++;
+        invalidateView();
+        return;
+    }
+
+    Node *newNode = pool.create(coefficient, degree);
+    if (tail == nullptr)
+        head = newNode;
+    else
+        tail->next = newNode;
+    tail = newNode;
+    listSize++;
+    adaptStorage();
+}
+
+/**
+ * @brief Makes room for `terms` more terms appended to a linked list without further heap allocations.
+ *
+ * @param terms The number of terms about to be appended.
+ */
+template <typename T>
+void BasicList<T>::reserve(int terms)
+{
+    if (!denseStorage && terms > 0)
+        pool.reserve((std::size_t)terms);
 }
 
 /**
@@ -133,16 +290,29 @@ void List::insert(float coefficient, int degree)
  * Searches for the node with the given degree and removes it from the list.
  * Updates the head and tail pointers as necessary.
  */
-void List::remove(int degree)
+template <typename T>
+void BasicList<T>::remove(int degree)
 {
     if (isEmpty())
         return;
 
+    if (denseStorage)
+    {
+        if (dense.getCoefficient(degree) != T(0))
+        {
+            dense.setCoefficient(degree, T(0));
+            listSize--;
+            invalidateView();
+            adaptStorage();
+        }
+        return;
+    }
+
     if (head->degree == degree)
     {
         Node *temp = head;
         head = head->next;
-        delete temp;
+        pool.destroy(temp);
         if (head == nullptr)
             tail = nullptr;
         listSize--;
@@ -161,7 +331,7 @@ void List::remove(int degree)
         current->next = temp->next;
         if (temp == tail)
             tail = current;
-        delete temp;
+        pool.destroy(temp);
         listSize--;
     }
 }
@@ -172,8 +342,11 @@ void List::remove(int degree)
  * @param degree The degree to search for.
  * @return `true` if a term with the given degree exists; otherwise, `false`.
  */
-bool List::exists(int degree) const
+template <typename T>
+bool BasicList<T>::exists(int degree) const
 {
+    if (denseStorage)
+        return dense.getCoefficient(degree) != T(0);
     return search(degree) != nullptr;
 }
 
@@ -182,7 +355,8 @@ bool List::exists(int degree) const
  *
  * @return The total number of terms (nodes) in the list.
  */
-int List::size() const
+template <typename T>
+int BasicList<T>::size() const
 {
     return listSize;
 }
@@ -192,9 +366,22 @@ int List::size() const
  *
  * @return `true` if the list is empty; otherwise, `false`.
  */
-bool List::isEmpty() const
+template <typename T>
+bool BasicList<T>::isEmpty() const
+{
+    return listSize == 0;
+}
+
+/**
+ * @brief Empties the polynomial while keeping its node storage for reuse.
+ *
+ * Cheaper than assigning a fresh `List()`: the nodes are released in bulk and the pool keeps its
+ * latest chunk, so refilling the list with a similar number of terms does not allocate.
+ */
+template <typename T>
+void BasicList<T>::reset()
 {
-    return head == nullptr;
+    clear();
 }
 
 /**
@@ -203,9 +390,10 @@ bool List::isEmpty() const
  * @param degree The degree of the term to search for.
  * @return Pointer to the node with the specified degree if found; otherwise, `nullptr`.
  */
-Node *List::search(int degree) const
+template <typename T>
+BasicNode<T> *BasicList<T>::search(int degree) const
 {
-    Node *current = head;
+    Node *current = getHead();
     while (current != nullptr)
     {
         if (current->degree == degree)
@@ -220,8 +408,11 @@ Node *List::search(int degree) const
  *
  * @return Pointer to the head node.
  */
-Node *List::getHead() const
+template <typename T>
+BasicNode<T> *BasicList<T>::getHead() const
 {
+    if (denseStorage)
+        buildView();
     return head;
 }
 
@@ -231,7 +422,8 @@ Node *List::getHead() const
  * @param node Pointer to the current node.
  * @return Pointer to the next node if it exists; otherwise, `nullptr`.
  */
-Node *List::getNext(Node *node) const
+template <typename T>
+BasicNode<T> *BasicList<T>::getNext(Node *node) const
 {
     if (node == nullptr)
         return nullptr;
@@ -242,13 +434,22 @@ Node *List::getNext(Node *node) const
  * @brief Retrieves the coefficient and degree of a term by its degree.
  *
  * @param degree The degree of the term to retrieve.
- * @return A tuple containing the coefficient and degree. Returns {0.0f, 0} if not found.
+ * @return A tuple containing the coefficient and degree. Returns {T(0), 0} if not found.
  */
-std::tuple<float, int> List::getValues(int degree) const
+template <typename T>
+std::tuple<T, int> BasicList<T>::getValues(int degree) const
 {
+    if (denseStorage)
+    {
+        T coeff = dense.getCoefficient(degree);
+        if (coeff == T(0))
+            return {T(0), 0};
+        return {coeff, degree};
+    }
+
     Node *node = search(degree);
     if (node == nullptr)
-        return {0.0f, 0};
+        return {T(0), 0};
     return {node->coefficient, node->degree};
 }
 
@@ -257,182 +458,497 @@ std::tuple<float, int> List::getValues(int degree) const
  *
  * @return The degree of the first term (highest degree) if the list is not empty; otherwise, `0`.
  */
-int List::getDegree() const
+template <typename T>
+int BasicList<T>::getDegree() const
 {
     if (isEmpty())
         return 0;
 
+    if (denseStorage)
+        return dense.getDegree();
     return head->degree;
 }
 
+/**
+ * @brief Checks whether the polynomial currently uses dense storage.
+ *
+ * @return `true` if the terms live in a coefficient array; `false` if they live in the node chain.
+ */
+template <typename T>
+bool BasicList<T>::isDenseStorage() const
+{
+    return denseStorage;
+}
+
+/**
+ * @brief Gives read access to the dense storage.
+ *
+ * @return Reference to the coefficient array; it is only meaningful when `isDenseStorage()` is `true`.
+ */
+template <typename T>
+const BasicDensePolynomial<T> &BasicList<T>::getDenseStorage() const
+{
+    return dense;
+}
+
+/**
+ * @brief Expands the polynomial into a coefficient vector indexed by degree.
+ *
+ * @return A vector of `getDegree() + 1` coefficients (empty if the list is empty).
+ */
+template <typename T>
+std::vector<typename BasicList<T>::Accumulator> BasicList<T>::getCoefficients() const
+{
+    std::vector<Accumulator> coefficients;
+    if (isEmpty())
+        return coefficients;
+
+    coefficients.assign(getDegree() + 1, Accumulator(0));
+    if (denseStorage)
+    {
+        const T *data = dense.data();
+        for (size_t i = 0; i < coefficients.size(); i++)
+            coefficients[i] = data[i];
+        return coefficients;
+    }
+
+    for (Node *current = head; current != nullptr; current = current->next)
+        coefficients[current->degree] = current->coefficient;
+    return coefficients;
+}
+
+/**
+ * @brief Builds a polynomial from a coefficient vector indexed by degree, the inverse of `getCoefficients`.
+ *
+ * @param coefficients The coefficients in the accumulator type, converted back to T.
+ * @return The polynomial, built on a coefficient array (zero if the vector is empty).
+ */
+template <typename T>
+BasicList<T> BasicList<T>::fromCoefficients(const std::vector<Accumulator> &coefficients)
+{
+    BasicDensePolynomial<T> dense;
+    for (int degree = (int)coefficients.size() - 1; degree >= 0; degree--)
+        dense.setCoefficient(degree, (T)coefficients[degree]);
+    return BasicList<T>(std::move(dense));
+}
+
+/**
+ * @brief Returns the bits of a coefficient that identify its value, for `hash`.
+ */
+static uint64_t coefficientBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static uint64_t coefficientBits(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static uint64_t coefficientBits(int64_t value)
+{
+    return (uint64_t)value;
+}
+
+static uint64_t coefficientBits(ModInt value)
+{
+    return value.value();
+}
+
+/**
+ * @brief Scrambles the bits of a 64-bit value (the finalizer of SplitMix64).
+ */
+static uint64_t mixBits(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Computes a canonical 64-bit hash of the polynomial.
+ *
+ * @param seed Selects the hash function; hashes with different seeds start from different states,
+ *             so two polynomials that collide under one seed almost never collide under another.
+ * @return A hash of the terms in descending degree order, with the number of terms.
+ *
+ * Equal polynomials hash the same whatever their storage and however they were built, and the
+ * hash does not change between runs, so it can key results kept on disk. Zero coefficients of the
+ * dense storage are skipped, as they have no term in the linked one.
+ */
+template <typename T>
+uint64_t BasicList<T>::hash(uint64_t seed) const
+{
+    uint64_t value = mixBits(0x9e3779b97f4a7c15ull + (uint64_t)listSize);
+    if (seed != 0)
+        value = mixBits(value ^ mixBits(seed));
+    auto addTerm = [&value](T coefficient, int degree)
+    {
+        value = mixBits(value ^ coefficientBits(coefficient));
+        value = mixBits(value ^ (uint64_t)(uint32_t)degree);
+    };
+
+    if (denseStorage)
+    {
+        const T *data = dense.data();
+        for (int degree = dense.getDegree(); degree >= 0; degree--)
+        {
+            if (data[degree] != T(0))
+                addTerm(data[degree], degree);
+        }
+        return value;
+    }
+
+    for (Node *current = head; current != nullptr; current = current->next)
+        addTerm(current->coefficient, current->degree);
+    return value;
+}
+
+/**
+ * @brief Returns a value with a floating-point -0 replaced by +0; other values are returned as they are.
+ */
+template <typename T>
+static T positiveZero(T value)
+{
+    return value == T(0) ? T(0) : value;
+}
+
+/**
+ * @brief Raises a value to a non-negative integer power by repeated squaring.
+ */
+template <typename T>
+static T powInt(T base, int exponent)
+{
+    T result(1);
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+            result *= base;
+        base *= base;
+        exponent >>= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Multiplies every lane of `acc` by the matching lane of `xs` raised to `exponent`.
+ *
+ * Runs over a whole block of lanes with a fixed trip count, so every loop is vectorized.
+ */
+template <typename T>
+static void multiplyByPower(T *__restrict acc, const T *__restrict xs, int exponent)
+{
+    if (exponent == 1)
+    {
+        for (size_t i = 0; i < BasicList<T>::EVALUATION_BLOCK; i++)
+            acc[i] *= xs[i];
+        return;
+    }
+
+    T power[BasicList<T>::EVALUATION_BLOCK];
+    for (size_t i = 0; i < BasicList<T>::EVALUATION_BLOCK; i++)
+        power[i] = xs[i];
+
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+        {
+            for (size_t i = 0; i < BasicList<T>::EVALUATION_BLOCK; i++)
+                acc[i] *= power[i];
+        }
+        exponent >>= 1;
+        if (exponent > 0)
+        {
+            for (size_t i = 0; i < BasicList<T>::EVALUATION_BLOCK; i++)
+                power[i] *= power[i];
+        }
+    }
+}
+
 /**
  * @brief Evaluates the polynomial for a given value of x.
  *
  * @param x The value at which to evaluate the polynomial.
+ * @param out The buffer receiving the output (the standard output by default).
  *
- * Calculates the result by summing each term's coefficient multiplied by x raised to the term's degree.
- * Outputs the evaluation process and result to the console.
+ * Computes the value with `evaluateAt` and outputs the evaluation process and result to `out`.
  *
  * @note If the list is empty, the result is `0`.
  */
-void List::evaluate(float x)
+template <typename T>
+void BasicList<T>::evaluate(T x, OutputBuffer &out)
 {
+    out << "p(";
+    out.writeValue(x) << ") = ";
     if (isEmpty())
     {
-        std::cout << "p(" << x << ") = 0" << std::endl;
+        out << "0\n";
         return;
     }
 
-    float result = 0.0f;
+    T result = evaluateAt(x);
+    format(out, &x);
+    out << " = ";
+    out.writeValue(result) << '\n';
+}
 
-    Node *current = head;
-    while (current != nullptr)
+/**
+ * @brief Computes the value of the polynomial at a given point.
+ *
+ * @param x The value at which to evaluate the polynomial.
+ * @return The value of the polynomial at `x` (`0` if the list is empty).
+ *
+ * Uses Horner's rule over the terms in descending degree order. Between two consecutive terms the
+ * accumulator is multiplied by x raised to the degree gap (by repeated squaring), so a sparse
+ * polynomial costs O(terms * log(gap)) instead of one multiplication per degree. With dense
+ * storage the plain Horner loop runs over the coefficient array.
+ *
+ * A zero value is returned as +0: the final multiplication by a power of x = 0 turns a negative
+ * coefficient into -0, which would be printed as "-0".
+ */
+template <typename T>
+T BasicList<T>::evaluateAt(T x) const
+{
+    if (isEmpty())
+        return T(0);
+
+    if (denseStorage)
     {
-        result += current->coefficient * std::pow(x, current->degree);
-        current = current->next;
+        const T *coefficients = dense.data();
+        int degree = dense.getDegree();
+        T result = coefficients[degree];
+        for (int i = degree - 1; i >= 0; i--)
+            result = result * x + coefficients[i];
+        return positiveZero(result);
     }
 
-    std::cout << "p(" << x << ") = ";
+    T result = head->coefficient;
+    for (Node *current = head; current->next != nullptr; current = current->next)
+    {
+        result = result * powInt(x, current->degree - current->next->degree) + current->next->coefficient;
+    }
+    return positiveZero(result * powInt(x, tail->degree));
+}
+
+/**
+ * @brief Computes the value of the polynomial at many points at once.
+ *
+ * @param xs Array of `n` points.
+ * @param out Array of `n` values receiving p(xs[i]).
+ * @param n The number of points.
+ *
+ * Runs the same gap-aware Horner scheme as `evaluateAt`, but each term is applied to a block of
+ * `EVALUATION_BLOCK` points in fixed-width loops that the compiler maps to SIMD lanes, and the
+ * list is walked once per block instead of once per point. Zero values are stored as +0, as in
+ * `evaluateAt`.
+ */
+template <typename T>
+void BasicList<T>::evaluateMany(const T *xs, T *out, size_t n) const
+{
+    T points[EVALUATION_BLOCK];
+    T acc[EVALUATION_BLOCK];
+
+    for (size_t start = 0; start < n; start += EVALUATION_BLOCK)
+    {
+        size_t count = n - start < EVALUATION_BLOCK ? n - start : EVALUATION_BLOCK;
+        for (size_t i = 0; i < EVALUATION_BLOCK; i++)
+            points[i] = i < count ? xs[start + i] : T(0);
+
+        if (isEmpty())
+        {
+            for (size_t i = 0; i < count; i++)
+                out[start + i] = T(0);
+            continue;
+        }
+
+        if (denseStorage)
+        {
+            const T *coefficients = dense.data();
+            int degree = dense.getDegree();
+            for (size_t i = 0; i < EVALUATION_BLOCK; i++)
+                acc[i] = coefficients[degree];
+            for (int d = degree - 1; d >= 0; d--)
+            {
+                T coeff = coefficients[d];
+                for (size_t i = 0; i < EVALUATION_BLOCK; i++)
+                    acc[i] = acc[i] * points[i] + coeff;
+            }
+            for (size_t i = 0; i < count; i++)
+                out[start + i] = positiveZero(acc[i]);
+            continue;
+        }
+
+        for (size_t i = 0; i < EVALUATION_BLOCK; i++)
+            acc[i] = head->coefficient;
+
+        for (Node *current = head; current->next != nullptr; current = current->next)
+        {
+            multiplyByPower(acc, points, current->degree - current->next->degree);
+            T coeff = current->next->coefficient;
+            for (size_t i = 0; i < EVALUATION_BLOCK; i++)
+                acc[i] += coeff;
+        }
+        multiplyByPower(acc, points, tail->degree);
 
-    std::cout << toString(x);
-    std::cout << " = " << result << std::endl;
+        for (size_t i = 0; i < count; i++)
+            out[start + i] = positiveZero(acc[i]);
+    }
 }
 
 /**
  * @brief Prints the polynomial to the console.
  *
  * @param endl If `true`, appends a newline character after printing; otherwise, no newline.
+ * @param out The buffer receiving the output (the standard output by default).
  *
- * Utilizes the `toString` method to generate a string representation of the polynomial.
+ * Utilizes the `format` method to write the polynomial straight into the buffer.
  * If the list is empty, prints `0`.
  */
-void List::showALL(bool endl) const
+template <typename T>
+void BasicList<T>::showALL(bool endl, OutputBuffer &out) const
 {
     if (isEmpty())
     {
-        std::cout << "0" << std::endl;
+        out << "0\n";
         return;
     }
 
-    std::cout << toString();
+    format(out);
 
     if (endl)
     {
-        std::cout << std::endl;
+        out << '\n';
     }
 }
 
 /**
  * @brief Generates a string representation of the polynomial.
  *
- * @param x Optional parameter used for formatting when evaluating the polynomial. Defaults to NaN.
+ * @param x Optional value substituted for x when printing an evaluation. Defaults to `nullptr` (prints "x").
  * @return A string representing the polynomial.
  *
- * Constructs the polynomial string by iterating through the list and formatting each term.
- * Handles positive and negative coefficients, as well as degrees for superscript representation.
+ * Collects the output of `format` in a detached buffer.
  */
-std::string List::toString(float x) const
+template <typename T>
+std::string BasicList<T>::toString(const T *x) const
 {
-    if (!head)
-        return "0";
+    OutputBuffer buffer;
+    format(buffer, x);
+    return std::string(buffer.view());
+}
 
-    Node *current = head;
-    std::string result;
-    bool first = true;
+/**
+ * @brief Writes the polynomial in its readable form, e.g. `3x² - x + 1`.
+ *
+ * @param out The buffer receiving the text.
+ * @param x Optional value substituted for x when printing an evaluation. Defaults to `nullptr` (prints "x").
+ *
+ * Writes the terms in descending degree order, handling positive and negative coefficients, as well
+ * as degrees for superscript representation. Numbers are formatted by `CoefficientTraits<T>::formatTo`
+ * straight into the buffer. An empty polynomial is written as `0`.
+ */
+template <typename T>
+void BasicList<T>::format(OutputBuffer &out, const T *x) const
+{
+    if (isEmpty())
+    {
+        out << '0';
+        return;
+    }
 
-    while (current)
+    bool first = true;
+    for (Node *current = getHead(); current != nullptr; current = current->next)
     {
-        float coeff = current->coefficient;
+        T coeff = current->coefficient;
         int deg = current->degree;
+        bool negative = Traits::isNegative(coeff);
+        T magnitude = negative ? -coeff : coeff;
 
-        if (coeff > 0 && !first)
-            result += " + ";
-        else if (coeff < 0 && first)
-            result += "-";
-        else if (coeff < 0)
-            result += " - ";
+        if (!negative && !first)
+            out << " + ";
+        else if (negative && first)
+            out << '-';
+        else if (negative)
+            out << " - ";
 
-        if (deg == 0 || std::abs(coeff) != 1.0f)
-            result += formatPrecision(std::abs(coeff));
+        if (deg == 0 || magnitude != T(1))
+            out.writeCoefficient(magnitude);
 
         if (deg > 0)
         {
-            if (std::isnan(x))
-                result += "x";
-            else if (coeff != 1.0f && coeff != -1.0f)
-                result += " x (" + formatPrecision(x) + ")";
+            if (x == nullptr)
+                out << 'x';
             else
-                result += "(" + formatPrecision(x) + ")";
+            {
+                out << (magnitude != T(1) ? " x (" : "(");
+                out.writeCoefficient(*x);
+                out << ')';
+            }
             if (deg > 1)
-                result += toSuperscript(deg);
+                writeSuperscript(out, deg);
         }
 
         first = false;
-        current = current->next;
     }
-
-    return result;
 }
 
 /**
- * @brief Formats a floating-point number to a string with appropriate precision.
+ * @brief Writes the polynomial as `coefficient degree` pairs, the format of the input lines.
  *
- * @param number The number to format.
- * @return A string representation of the number with up to two decimal places if necessary.
+ * @param out The buffer receiving the text.
  *
- * If the number is an integer, it is converted without decimal places.
- * Otherwise, it is formatted with two decimal places.
+ * Coefficients are written by `CoefficientTraits<T>::exactTo`, so reading the pairs back gives the
+ * same polynomial. An empty polynomial is written as `0 0`.
  */
-std::string List::formatPrecision(float number) const
+template <typename T>
+void BasicList<T>::formatPairs(OutputBuffer &out) const
 {
-    std::stringstream stream;
-    if (std::floor(number) == number)
+    if (isEmpty())
     {
-        return std::to_string((int)number);
+        out << "0 0";
+        return;
     }
-    else
+
+    bool first = true;
+    for (Node *current = getHead(); current != nullptr; current = current->next)
     {
-        stream << std::fixed << std::setprecision(2) << number;
-        std::string s = stream.str();
-        return s;
+        if (!first)
+            out << ' ';
+        out.writeExact(current->coefficient);
+        out << ' ' << current->degree;
+        first = false;
     }
-    return std::to_string(number);
 }
 
 /**
- * @brief Converts an integer to its superscript string representation.
+ * @brief Writes an integer in Unicode superscript digits.
  *
- * @param number The integer to convert.
- * @return A string containing the superscript characters of the number.
+ * @param out The buffer receiving the text.
+ * @param number The integer to write.
  *
- * Maps each digit to its corresponding Unicode superscript character.
- * Example: 12 becomes "¹²".
+ * Maps each digit to its superscript character through a constant table, and a minus sign to
+ * the superscript minus. Example: 12 becomes "¹²", and -3 becomes "⁻³".
  */
-std::string List::toSuperscript(int number) const
+template <typename T>
+void BasicList<T>::writeSuperscript(OutputBuffer &out, int number)
 {
-    std::map<char, std::string> superscripts = {
-        {'0', "\u2070"},
-        {'1', "\u00B9"},
-        {'2', "\u00B2"},
-        {'3', "\u00B3"},
-        {'4', "\u2074"},
-        {'5', "\u2075"},
-        {'6', "\u2076"},
-        {'7', "\u2077"},
-        {'8', "\u2078"},
-        {'9', "\u2079"},
+    static constexpr std::string_view SUPERSCRIPTS[10] = {
+        "\u2070", "\u00B9", "\u00B2", "\u00B3", "\u2074", "\u2075", "\u2076", "\u2077", "\u2078", "\u2079",
     };
 
-    // convert number to string
-    std::string numberStr = std::to_string(number);
-
-    std::string result = "";
-    for (char digit : numberStr)
+    char digits[16];
+    char *end = std::to_chars(digits, digits + sizeof(digits), number).ptr;
+    for (const char *digit = digits; digit != end; digit++)
     {
-        result += superscripts[digit];
+        if (*digit == '-')
+            out << "\u207B";
+        else
+            out << SUPERSCRIPTS[*digit - '0'];
     }
-
-    return result;
 }
 
 /**
@@ -445,19 +961,23 @@ std::string List::toSuperscript(int number) const
  * If a node with `currentDegree` exists, its coefficient is updated. If the new coefficient is zero,
  * the node is removed. If the node does not exist, a new term is inserted.
  */
-void List::changeNode(int currentDegree, float coefficient, int degree)
+template <typename T>
+void BasicList<T>::changeNode(int currentDegree, T coefficient, int degree)
 {
+    if (denseStorage)
+        toSparse();
+
     Node *node = search(currentDegree);
     if (node == nullptr)
     {
-        std::cerr << "Grau " << currentDegree << " não encontrado. Inserindo novo termo.\n";
+        errorOutput() << "Grau " << currentDegree << " não encontrado. Inserindo novo termo.\n";
         insert(coefficient, degree);
         return;
     }
 
     node->coefficient = coefficient;
 
-    if (node->coefficient == 0.0f)
+    if (node->coefficient == T(0))
     {
         remove(degree);
     }
@@ -469,20 +989,28 @@ void List::changeNode(int currentDegree, float coefficient, int degree)
  * @param other The List object to add to the current polynomial.
  * @return A new List object representing the sum of the two polynomials.
  *
- * Creates a copy of the current polynomial, inserts all terms from `other`, and returns the result.
+ * Both lists are sorted by descending degree, so the result is built in a single merge pass.
  */
-List List::operator+(const List &other) const
+template <typename T>
+BasicList<T> BasicList<T>::operator+(const BasicList &other) const &
 {
-    List result(*this); // Start with a copy of the current polynomial
-
-    Node *current = other.head;
-    while (current != nullptr)
-    {
-        result.insert(current->coefficient, current->getDegree());
-        current = current->getNext();
-    }
+    return merge(other, T(1));
+}
 
-    return result;
+/**
+ * @brief Adds a polynomial to a temporary one, reusing the temporary's storage.
+ *
+ * @param other The List object to add.
+ * @return The current (expiring) List object with `other` merged into it.
+ *
+ * Selected for expressions such as `(a + b) + c` or `std::move(a) + b`: the left operand is
+ * updated in place and moved into the result, so its nodes are not copied.
+ */
+template <typename T>
+BasicList<T> BasicList<T>::operator+(const BasicList &other) &&
+{
+    mergeInto(other, T(1));
+    return std::move(*this);
 }
 
 /**
@@ -491,20 +1019,53 @@ List List::operator+(const List &other) const
  * @param other The List object to subtract from the current polynomial.
  * @return A new List object representing the difference between the two polynomials.
  *
- * Creates a copy of the current polynomial, inserts all negated terms from `other`, and returns the result.
+ * Builds the result in a single merge pass, negating the terms taken from `other`.
  */
-List List::operator-(const List &other) const
+template <typename T>
+BasicList<T> BasicList<T>::operator-(const BasicList &other) const &
 {
-    List result(*this); // Start with a copy of the current polynomial
+    return merge(other, T(-1));
+}
 
-    Node *current = other.head;
-    while (current != nullptr)
-    {
-        result.insert(-current->coefficient, current->getDegree());
-        current = current->getNext();
-    }
+/**
+ * @brief Subtracts a polynomial from a temporary one, reusing the temporary's storage.
+ *
+ * @param other The List object to subtract.
+ * @return The current (expiring) List object with `other` subtracted from it.
+ */
+template <typename T>
+BasicList<T> BasicList<T>::operator-(const BasicList &other) &&
+{
+    mergeInto(other, T(-1));
+    return std::move(*this);
+}
 
-    return result;
+/**
+ * @brief Adds another polynomial into the current one, in place.
+ *
+ * @param other The List object to add.
+ * @return Reference to the current List object.
+ *
+ * Existing nodes are updated (or removed when they cancel out) and new terms are linked in place.
+ */
+template <typename T>
+BasicList<T> &BasicList<T>::operator+=(const BasicList &other)
+{
+    mergeInto(other, T(1));
+    return *this;
+}
+
+/**
+ * @brief Subtracts another polynomial from the current one, in place.
+ *
+ * @param other The List object to subtract.
+ * @return Reference to the current List object.
+ */
+template <typename T>
+BasicList<T> &BasicList<T>::operator-=(const BasicList &other)
+{
+    mergeInto(other, T(-1));
+    return *this;
 }
 
 /**
@@ -513,28 +1074,23 @@ List List::operator-(const List &other) const
  * @param other The List object to multiply with the current polynomial.
  * @return A new List object representing the product of the two polynomials.
  *
- * Performs a nested iteration over both polynomials, multiplying each term from the current polynomial
- * with each term from `other`, and inserts the resulting terms into the result polynomial.
+ * When both operands are dense (see `isDense`), the product is computed on coefficient arrays by
+ * `denseMultiply`, which uses Karatsuba above `karatsubaThreshold` and the FFT/NTT engine above
+ * `convolutionThreshold`. Otherwise, `sparseMultiply` produces the terms in descending degree
+ * order through a heap and appends them to the result without searching it.
+ *
+ * @throws std::overflow_error If the degree of the product does not fit in an int.
  */
-List List::operator*(const List &other) const
+template <typename T>
+BasicList<T> BasicList<T>::operator*(const BasicList &other) const
 {
-    List result;
+    if ((int64_t)getDegree() + other.getDegree() > INT_MAX)
+        throw std::overflow_error("grau do produto grande demais");
 
-    Node *currentThis = head;
-    while (currentThis != nullptr)
-    {
-        Node *currentOther = other.head;
-        while (currentOther != nullptr)
-        {
-            float coeff = currentThis->coefficient * currentOther->coefficient;
-            int deg = currentThis->degree + currentOther->degree;
-            result.insert(coeff, deg);
-            currentOther = currentOther->next;
-        }
-        currentThis = currentThis->next;
-    }
+    if (isDense(*this) && isDense(other))
+        return denseMultiply(*this, other);
 
-    return result;
+    return sparseMultiply(*this, other);
 }
 
 /**
@@ -546,7 +1102,8 @@ List List::operator*(const List &other) const
  *
  * Utilizes the `toString` method to convert the polynomial to a string and inserts it into the stream.
  */
-std::ostream &operator<<(std::ostream &os, const List &list)
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const BasicList<T> &list)
 {
     if (list.isEmpty())
     {
@@ -562,19 +1119,18 @@ std::ostream &operator<<(std::ostream &os, const List &list)
 /**
  * @brief Helper method to delete all nodes in the list.
  *
- * Iterates through the list, deletes each node, and resets the head, tail, and list size.
+ * Releases every node at once through the pool, empties the dense storage (keeping its buffer)
+ * and resets the head, tail, and list size.
  */
-void List::clear()
+template <typename T>
+void BasicList<T>::clear()
 {
-    Node *current = head;
-    while (current != nullptr)
-    {
-        Node *nextNode = current->next;
-        delete current;
-        current = nextNode;
-    }
+    pool.reset();
     head = tail = nullptr;
     listSize = 0;
+    dense.clear();
+    denseStorage = false;
+    viewValid = false;
 }
 
 /**
@@ -582,9 +1138,11 @@ void List::clear()
  *
  * @param other The List object to copy from.
  *
- * Copies all nodes from the `other` list into the current list, maintaining the order of terms.
+ * Copies all nodes from the `other` list into the current list, maintaining the order of terms,
+ * or its coefficient array when `other` uses dense storage.
  */
-void List::copyFrom(const List &other)
+template <typename T>
+void BasicList<T>::copyFrom(const BasicList &other)
 {
     if (other.isEmpty())
     {
@@ -593,8 +1151,19 @@ void List::copyFrom(const List &other)
         return;
     }
 
+    if (other.denseStorage)
+    {
+        dense = other.dense;
+        denseStorage = true;
+        viewValid = false;
+        listSize = other.listSize;
+        return;
+    }
+
+    pool.reserve(other.listSize);
+
     // Copy the head node
-    head = new Node(other.head->coefficient, other.head->degree);
+    head = pool.create(other.head->coefficient, other.head->degree);
     listSize = 1;
     Node *currentOther = other.head->next;
     Node *currentThis = head;
@@ -602,7 +1171,7 @@ void List::copyFrom(const List &other)
     // Copy the rest of the nodes
     while (currentOther != nullptr)
     {
-        Node *newNode = new Node(currentOther->coefficient, currentOther->degree);
+        Node *newNode = pool.create(currentOther->coefficient, currentOther->degree);
         currentThis->next = newNode;
         currentThis = newNode;
         currentOther = currentOther->next;
@@ -610,4 +1179,301 @@ void List::copyFrom(const List &other)
     }
 
     tail = currentThis;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Helper method that merges two sorted lists into a new one.
+ *
+ * @param other The List object to merge with the current polynomial.
+ * @param sign Factor applied to the coefficients taken from `other` (1 to add, -1 to subtract).
+ * @return A new List object with the merged terms.
+ *
+ * Walks both lists once, so the cost is O(n + m). Terms that cancel out are dropped. When one
+ * operand uses dense storage and the result fits in an array, the other operand is added into a
+ * copy of the array instead (with the vectorized kernel if both are dense).
+ */
+template <typename T>
+BasicList<T> BasicList<T>::merge(const BasicList &other, T sign) const
+{
+    if ((denseStorage || other.denseStorage) && fitsDense(other))
+    {
+        BasicList result(denseStorage ? dense : BasicDensePolynomial<T>(*this));
+        if (!result.denseStorage)
+            result.toDense();
+        result.accumulateDense(other, sign);
+        return result;
+    }
+
+    BasicList result;
+    Node *currentThis = getHead();
+    Node *currentOther = other.getHead();
+
+    while (currentThis != nullptr && currentOther != nullptr)
+    {
+        if (currentThis->degree > currentOther->degree)
+        {
+            result.append(currentThis->coefficient, currentThis->degree);
+            currentThis = currentThis->next;
+        }
+        else if (currentThis->degree < currentOther->degree)
+        {
+            result.append(sign * currentOther->coefficient, currentOther->degree);
+            currentOther = currentOther->next;
+        }
+        else
+        {
+            T coeff = currentThis->coefficient + sign * currentOther->coefficient;
+            if (coeff != T(0))
+                result.append(coeff, currentThis->degree);
+            currentThis = currentThis->next;
+            currentOther = currentOther->next;
+        }
+    }
+
+    for (; currentThis != nullptr; currentThis = currentThis->next)
+        result.append(currentThis->coefficient, currentThis->degree);
+
+    for (; currentOther != nullptr; currentOther = currentOther->next)
+        result.append(sign * currentOther->coefficient, currentOther->degree);
+
+    return result;
+}
+
+/**
+ * @brief Helper method that merges another sorted list into the current one.
+ *
+ * @param other The List object to merge into the current polynomial.
+ * @param sign Factor applied to the coefficients taken from `other` (1 to add, -1 to subtract).
+ *
+ * Reuses the existing nodes: matching degrees are updated in place, cancelled terms are unlinked
+ * and missing degrees are linked between their neighbours. The cost is O(n + m). When either
+ * list uses dense storage and the result fits in an array, the merge happens in the array instead.
+ */
+template <typename T>
+void BasicList<T>::mergeInto(const BasicList &other, T sign)
+{
+    if (this == &other)
+    {
+        if (sign != T(1))
+        {
+            clear();
+            return;
+        }
+        if (denseStorage)
+        {
+            dense *= T(2);
+            invalidateView();
+            return;
+        }
+        for (Node *current = head; current != nullptr; current = current->next)
+            current->coefficient += current->coefficient;
+        return;
+    }
+
+    if ((denseStorage || other.denseStorage) && fitsDense(other))
+    {
+        if (!denseStorage)
+            toDense();
+        accumulateDense(other, sign);
+        return;
+    }
+
+    if (denseStorage)
+        toSparse();
+
+    Node *previous = nullptr;
+    Node *current = head;
+
+    for (Node *source = other.getHead(); source != nullptr; source = source->next)
+    {
+        while (current != nullptr && current->degree > source->degree)
+        {
+            previous = current;
+            current = current->next;
+        }
+
+        if (current != nullptr && current->degree == source->degree)
+        {
+            current->coefficient += sign * source->coefficient;
+            if (current->coefficient != T(0))
+            {
+                previous = current;
+                current = current->next;
+                continue;
+            }
+
+            // The term cancelled out: unlink it
+            Node *temp = current;
+            current = current->next;
+            if (previous == nullptr)
+                head = current;
+            else
+                previous->next = current;
+            if (temp == tail)
+                tail = previous;
+            pool.destroy(temp);
+            listSize--;
+            continue;
+        }
+
+        Node *newNode = pool.create(sign * source->coefficient, source->degree);
+        newNode->next = current;
+        if (previous == nullptr)
+            head = newNode;
+        else
+            previous->next = newNode;
+        if (current == nullptr)
+            tail = newNode;
+        previous = newNode;
+        listSize++;
+    }
+
+    adaptStorage();
+}
+
+/**
+ * @brief Helper method that builds the read-only node view of the dense storage.
+ *
+ * Does nothing if the view is already up to date. The nodes come from the list's pool.
+ */
+template <typename T>
+void BasicList<T>::buildView() const
+{
+    if (viewValid)
+        return;
+
+    pool.reset();
+    head = tail = nullptr;
+
+    const T *coefficients = dense.data();
+    for (int degree = dense.getDegree(); degree >= 0 && listSize > 0; degree--)
+    {
+        if (coefficients[degree] == T(0))
+            continue;
+
+        Node *newNode = pool.create(coefficients[degree], degree);
+        if (tail == nullptr)
+            head = newNode;
+        else
+            tail->next = newNode;
+        tail = newNode;
+    }
+    viewValid = true;
+}
+
+/**
+ * @brief Helper method that drops the node view after the dense storage changed.
+ */
+template <typename T>
+void BasicList<T>::invalidateView()
+{
+    if (!denseStorage || !viewValid)
+        return;
+
+    pool.reset();
+    head = tail = nullptr;
+    viewValid = false;
+}
+
+/**
+ * @brief Helper method that moves the terms from the node chain to a coefficient array.
+ */
+template <typename T>
+void BasicList<T>::toDense()
+{
+    dense.clear();
+    for (Node *current = head; current != nullptr; current = current->next)
+        dense.setCoefficient(current->degree, current->coefficient);
+
+    pool.reset();
+    head = tail = nullptr;
+    denseStorage = true;
+    viewValid = false;
+}
+
+/**
+ * @brief Helper method that moves the terms from the coefficient array back to the node chain.
+ *
+ * The node view already has the right shape, so it becomes the real chain.
+ */
+template <typename T>
+void BasicList<T>::toSparse()
+{
+    buildView();
+    dense.clear();
+    denseStorage = false;
+    viewValid = false;
+}
+
+/**
+ * @brief Helper method that switches the storage when the density crosses the thresholds.
+ *
+ * Linked lists with at least `minDenseTerms` terms and a density of at least `denseRatio` become
+ * dense; dense lists whose density falls below `sparseRatio` go back to linked storage.
+ */
+template <typename T>
+void BasicList<T>::adaptStorage()
+{
+    const StorageSettings &settings = storageSettings();
+    float length = getDegree() + 1.0f;
+
+    if (!denseStorage && listSize >= settings.minDenseTerms && listSize >= settings.denseRatio * length)
+        toDense();
+    else if (denseStorage && listSize < settings.sparseRatio * length)
+        toSparse();
+}
+
+/**
+ * @brief Helper method that checks whether the sum with another list fits in a coefficient array.
+ *
+ * @param other The other operand.
+ * @return `true` if the terms of both lists would fill at least `sparseRatio` of the result range.
+ */
+template <typename T>
+bool BasicList<T>::fitsDense(const BasicList &other) const
+{
+    float length = std::max(getDegree(), other.getDegree()) + 1.0f;
+    return listSize + other.listSize >= storageSettings().sparseRatio * length;
+}
+
+/**
+ * @brief Helper method that adds `sign * other` into the dense storage.
+ *
+ * @param other The List object to accumulate.
+ * @param sign Factor applied to the coefficients of `other` (1 to add, -1 to subtract).
+ *
+ * Uses the vectorized DensePolynomial kernel when `other` is dense too, and scatters its terms
+ * otherwise. The current list must use dense storage.
+ */
+template <typename T>
+void BasicList<T>::accumulateDense(const BasicList &other, T sign)
+{
+    if (other.denseStorage)
+    {
+        if (sign == T(1))
+            dense += other.dense;
+        else
+            dense -= other.dense;
+    }
+    else
+    {
+        for (Node *current = other.head; current != nullptr; current = current->next)
+        {
+            dense.setCoefficient(current->degree, dense.getCoefficient(current->degree) + sign * current->coefficient);
+        }
+    }
+
+    listSize = dense.size();
+    invalidateView();
+    adaptStorage();
+}
+
+template class BasicList<float>;
+template class BasicList<double>;
+template class BasicList<int64_t>;
+template class BasicList<ModInt>;
+
+template std::ostream &operator<<(std::ostream &os, const BasicList<float> &list);
+template std::ostream &operator<<(std::ostream &os, const BasicList<double> &list);
+template std::ostream &operator<<(std::ostream &os, const BasicList<int64_t> &list);
+template std::ostream &operator<<(std::ostream &os, const BasicList<ModInt> &list);
@@ -0,0 +1,58 @@
+#include "../include/ModInt.h"
+
+/**
+ * @class ModInt
+ * @brief Integer modulo the prime `MODULUS`, kept in Montgomery form.
+ *
+ * Storing value * 2^32 instead of the value turns every multiplication into one 64-bit product
+ * followed by a Montgomery reduction (two more multiplications and a shift), with no division.
+ * Values enter and leave Montgomery form only when they are built from an integer or printed.
+ */
+
+/**
+ * @brief Raises the value to a non-negative integer power by repeated squaring.
+ *
+ * @param exponent The power to raise the value to.
+ * @return The value raised to `exponent`.
+ */
+ModInt ModInt::pow(uint64_t exponent) const
+{
+    ModInt result(1), base = *this;
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+            result *= base;
+        base *= base;
+        exponent >>= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Computes the multiplicative inverse through Fermat's little theorem.
+ *
+ * @return The inverse of the value, or `0` if the value is `0`.
+ */
+ModInt ModInt::inverse() const
+{
+    return pow(MODULUS - 2);
+}
+
+/**
+ * @brief Prints the canonical residue, in [0, MODULUS).
+ */
+std::ostream &operator<<(std::ostream &os, ModInt value)
+{
+    return os << value.value();
+}
+
+/**
+ * @brief Reads an integer and reduces it modulo `MODULUS` (negative values included).
+ */
+std::istream &operator>>(std::istream &is, ModInt &value)
+{
+    long long integer;
+    if (is >> integer)
+        value = ModInt((int64_t)integer);
+    return is;
+}
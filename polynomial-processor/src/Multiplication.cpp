@@ -0,0 +1,768 @@
+#include "../include/Multiplication.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Returns the settings shared by every multiplication.
+ *
+ * @return Reference to the process-wide MultiplicationSettings object, which may be tuned at startup.
+ */
+MultiplicationSettings &multiplicationSettings()
+{
+    static MultiplicationSettings settings;
+    return settings;
+}
+
+/**
+ * @brief Checks whether a polynomial is dense enough for the coefficient-array kernels.
+ *
+ * @param poly The polynomial to check.
+ * @return `true` if the fraction of non-zero coefficients reaches `storageSettings().denseRatio`; otherwise, `false`.
+ *
+ * The threshold is the one at which a list switches to dense storage, so an operand stored as a
+ * coefficient array is handed to the array kernels, and a linked one to the sparse kernels, unless
+ * it has fewer than `minDenseTerms` terms, which only the storage requires.
+ */
+template <typename T>
+bool isDense(const BasicList<T> &poly)
+{
+    return poly.size() >= storageSettings().denseRatio * (poly.getDegree() + 1.0f);
+}
+
+/**
+ * @brief Multiplies two coefficient arrays with the schoolbook double loop.
+ *
+ * @param a Coefficients of the first operand, indexed by degree.
+ * @param n Number of coefficients in `a`.
+ * @param b Coefficients of the second operand, indexed by degree.
+ * @param m Number of coefficients in `b`.
+ * @param out Buffer of `n + m - 1` coefficients receiving the product (overwritten).
+ *
+ * The inner loop is a plain multiply-add over contiguous memory, which the compiler vectorizes for
+ * double and int64_t. For ModInt every product goes through one Montgomery reduction.
+ */
+template <typename A>
+void schoolbookMultiply(const A *a, int n, const A *b, int m, A *out)
+{
+    std::fill(out, out + n + m - 1, A(0));
+    for (int i = 0; i < n; i++)
+    {
+        A coeff = a[i];
+        A *__restrict row = out + i;
+        for (int j = 0; j < m; j++)
+        {
+            row[j] += coeff * b[j];
+        }
+    }
+}
+
+/**
+ * @brief Squares a coefficient array with the schoolbook double loop, computing each cross product once.
+ *
+ * @param a Coefficients of the operand, indexed by degree.
+ * @param n Number of coefficients in `a` (at least one).
+ * @param out Buffer of `2n - 1` coefficients receiving the square (overwritten).
+ *
+ * The products a[i] * a[j] with i < j are summed once and doubled, and the squares a[i]^2 added
+ * on the even degrees, so the square takes about half the products of `schoolbookMultiply`.
+ */
+template <typename A>
+void schoolbookSquare(const A *a, int n, A *out)
+{
+    std::fill(out, out + 2 * n - 1, A(0));
+    for (int i = 0; i < n; i++)
+    {
+        A coeff = a[i];
+        A *__restrict row = out + i;
+        for (int j = i + 1; j < n; j++)
+        {
+            row[j] += coeff * a[j];
+        }
+    }
+    for (int i = 0; i < 2 * n - 1; i++)
+    {
+        out[i] += out[i];
+    }
+    for (int i = 0; i < n; i++)
+    {
+        out[2 * i] += a[i] * a[i];
+    }
+}
+
+/**
+ * @brief Returns the Karatsuba cutover length, never below one coefficient.
+ */
+static int cutover()
+{
+    return std::max(1, multiplicationSettings().karatsubaThreshold);
+}
+
+/**
+ * @brief Returns the scratch size needed by `karatsubaRecursive` for operands of length `n`.
+ */
+static int karatsubaScratch(int n)
+{
+    int total = 0;
+    while (n > cutover())
+    {
+        int high = n - n / 2;
+        total += 4 * high;
+        n = high;
+    }
+    return total;
+}
+
+/**
+ * @brief Karatsuba product of two arrays of the same length.
+ *
+ * @param a Coefficients of the first operand.
+ * @param b Coefficients of the second operand.
+ * @param n Number of coefficients in each operand.
+ * @param out Buffer of `2n - 1` coefficients receiving the product (overwritten).
+ * @param scratch Work buffer of at least `karatsubaScratch(n)` coefficients.
+ *
+ * Splits each operand into a low half of `n / 2` and a high half of `n - n / 2` coefficients and
+ * computes three half-size products: low * low, high * high and (low + high) * (low + high).
+ */
+template <typename A>
+static void karatsubaRecursive(const A *a, const A *b, int n, A *out, A *scratch)
+{
+    if (n <= cutover())
+    {
+        schoolbookMultiply(a, n, b, n, out);
+        return;
+    }
+
+    int low = n / 2;
+    int high = n - low;
+
+    // out = z0 (low * low) | 0 | z2 (high * high)
+    karatsubaRecursive(a, b, low, out, scratch);
+    out[2 * low - 1] = A(0);
+    karatsubaRecursive(a + low, b + low, high, out + 2 * low, scratch);
+
+    // z1 = (a0 + a1)(b0 + b1) - z0 - z2
+    A *sumA = scratch;
+    A *sumB = scratch + high;
+    A *middle = scratch + 2 * high;
+    for (int i = 0; i < high; i++)
+    {
+        sumA[i] = a[low + i] + (i < low ? a[i] : A(0));
+        sumB[i] = b[low + i] + (i < low ? b[i] : A(0));
+    }
+    karatsubaRecursive(sumA, sumB, high, middle, scratch + 4 * high);
+
+    for (int i = 0; i < 2 * low - 1; i++)
+    {
+        middle[i] -= out[i];
+    }
+    for (int i = 0; i < 2 * high - 1; i++)
+    {
+        middle[i] -= out[2 * low + i];
+    }
+    for (int i = 0; i < 2 * high - 1; i++)
+    {
+        out[low + i] += middle[i];
+    }
+}
+
+/**
+ * @brief Karatsuba square of an array.
+ *
+ * @param a Coefficients of the operand.
+ * @param n Number of coefficients in `a`.
+ * @param out Buffer of `2n - 1` coefficients receiving the square (overwritten).
+ * @param scratch Work buffer of at least `karatsubaScratch(n)` coefficients (each level uses 3 of its 4 halves).
+ *
+ * The three half-size products of `karatsubaRecursive` are all squares here: low^2, high^2 and
+ * (low + high)^2, down to `schoolbookSquare` at the cutover.
+ */
+template <typename A>
+static void karatsubaSquareRecursive(const A *a, int n, A *out, A *scratch)
+{
+    if (n <= cutover())
+    {
+        schoolbookSquare(a, n, out);
+        return;
+    }
+
+    int low = n / 2;
+    int high = n - low;
+
+    // out = z0 (low^2) | 0 | z2 (high^2)
+    karatsubaSquareRecursive(a, low, out, scratch);
+    out[2 * low - 1] = A(0);
+    karatsubaSquareRecursive(a + low, high, out + 2 * low, scratch);
+
+    // z1 = (a0 + a1)^2 - z0 - z2
+    A *sum = scratch;
+    A *middle = scratch + high;
+    for (int i = 0; i < high; i++)
+    {
+        sum[i] = a[low + i] + (i < low ? a[i] : A(0));
+    }
+    karatsubaSquareRecursive(sum, high, middle, scratch + 3 * high);
+
+    for (int i = 0; i < 2 * low - 1; i++)
+    {
+        middle[i] -= out[i];
+    }
+    for (int i = 0; i < 2 * high - 1; i++)
+    {
+        middle[i] -= out[2 * low + i];
+    }
+    for (int i = 0; i < 2 * high - 1; i++)
+    {
+        out[low + i] += middle[i];
+    }
+}
+
+/**
+ * @brief Multiplies two coefficient arrays with Karatsuba's algorithm.
+ *
+ * @param a Coefficients of the first operand, indexed by degree.
+ * @param n Number of coefficients in `a`.
+ * @param b Coefficients of the second operand, indexed by degree.
+ * @param m Number of coefficients in `b`.
+ * @param out Buffer of `n + m - 1` coefficients receiving the product (overwritten).
+ *
+ * Runs in O(n^1.58) for balanced operands. An unbalanced product is split into slices of the
+ * longer operand, each as long as the shorter one, and the partial products are added at their offsets.
+ * Operands at or below `karatsubaThreshold` go straight to the schoolbook kernel.
+ */
+template <typename A>
+void karatsubaMultiply(const A *a, int n, const A *b, int m, A *out)
+{
+    if (n < m)
+    {
+        std::swap(a, b);
+        std::swap(n, m);
+    }
+
+    if (m <= cutover())
+    {
+        schoolbookMultiply(a, n, b, m, out);
+        return;
+    }
+
+    std::fill(out, out + n + m - 1, A(0));
+    std::vector<A> slice(m);
+    std::vector<A> partial(2 * m - 1);
+    std::vector<A> scratch(karatsubaScratch(m));
+
+    for (int offset = 0; offset < n; offset += m)
+    {
+        int count = std::min(m, n - offset);
+        std::copy(a + offset, a + offset + count, slice.begin());
+        std::fill(slice.begin() + count, slice.end(), A(0));
+
+        karatsubaRecursive(slice.data(), b, m, partial.data(), scratch.data());
+
+        int used = std::min(2 * m - 1, n + m - 1 - offset);
+        for (int i = 0; i < used; i++)
+        {
+            out[offset + i] += partial[i];
+        }
+    }
+}
+
+/**
+ * @brief Squares a coefficient array with Karatsuba's algorithm.
+ *
+ * @param a Coefficients of the operand, indexed by degree.
+ * @param n Number of coefficients in `a` (at least one).
+ * @param out Buffer of `2n - 1` coefficients receiving the square (overwritten).
+ */
+template <typename A>
+void karatsubaSquare(const A *a, int n, A *out)
+{
+    if (n <= cutover())
+    {
+        schoolbookSquare(a, n, out);
+        return;
+    }
+
+    std::vector<A> scratch(karatsubaScratch(n));
+    karatsubaSquareRecursive(a, n, out, scratch.data());
+}
+
+/**
+ * @brief Multiplies two real coefficient arrays through the FFT/NTT engine.
+ */
+static bool convolve(const double *a, int n, const double *b, int m, double *out)
+{
+    convolutionMultiply(a, n, b, m, out, multiplicationSettings().convolutionMode);
+    return true;
+}
+
+/**
+ * @brief Multiplies two integer coefficient arrays through the exact NTT, if its range is large enough.
+ */
+static bool convolve(const int64_t *a, int n, const int64_t *b, int m, int64_t *out)
+{
+    return nttMultiply(a, n, b, m, out);
+}
+
+/**
+ * @brief Multiplies two arrays of ModInt through a single NTT modulo ModInt::MODULUS.
+ *
+ * The Montgomery residues go through the transform as they are: the product of aR and bR comes out
+ * as abR^2, and one Montgomery reduction per coefficient brings it back to the Montgomery form abR.
+ * A square passes the same residues twice, so they are transformed once.
+ *
+ * ModInt::MODULUS only has transforms of up to `NTT_MAX_LENGTH`, so a longer product is split into
+ * blocks of half that length, whose products each fit in one transform and are added at their
+ * offsets: it stays exact, at the cost of one product per pair of blocks.
+ */
+static bool convolve(const ModInt *a, int n, const ModInt *b, int m, ModInt *out)
+{
+    if (n + m - 1 > NTT_MAX_LENGTH)
+    {
+        const int block = NTT_MAX_LENGTH / 2;
+        std::fill(out, out + n + m - 1, ModInt(0));
+        std::vector<ModInt> partial(2 * block - 1);
+        for (int i = 0; i < n; i += block)
+        {
+            for (int j = 0; j < m; j += block)
+            {
+                int lengthA = std::min(block, n - i);
+                int lengthB = std::min(block, m - j);
+                convolve(a + i, lengthA, b + j, lengthB, partial.data());
+                for (int k = 0; k < lengthA + lengthB - 1; k++)
+                    out[i + j + k] += partial[k];
+            }
+        }
+        return true;
+    }
+
+    bool square = a == b && n == m;
+    std::vector<uint32_t> x(n), y(square ? 0 : m), product(n + m - 1);
+    for (int i = 0; i < n; i++)
+        x[i] = a[i].montgomery();
+    for (int i = 0; i < (int)y.size(); i++)
+        y[i] = b[i].montgomery();
+
+    nttMultiplyModulo(x.data(), n, square ? x.data() : y.data(), m, product.data(), ModInt::MODULUS);
+    for (int i = 0; i < n + m - 1; i++)
+        out[i] = ModInt::fromMontgomery(ModInt::reduce(product[i]));
+    return true;
+}
+
+/**
+ * @brief Squares a real coefficient array through the FFT/NTT engine.
+ */
+static bool convolveSquare(const double *a, int n, double *out)
+{
+    convolutionSquare(a, n, out, multiplicationSettings().convolutionMode);
+    return true;
+}
+
+/**
+ * @brief Squares an integer coefficient array through the exact NTT, which transforms the operand once.
+ */
+static bool convolveSquare(const int64_t *a, int n, int64_t *out)
+{
+    return nttMultiply(a, n, a, n, out);
+}
+
+/**
+ * @brief Squares an array of ModInt through a single NTT, which transforms the operand once.
+ */
+static bool convolveSquare(const ModInt *a, int n, ModInt *out)
+{
+    return convolve(a, n, a, n, out);
+}
+
+/**
+ * @brief Multiplies two coefficient arrays through the fastest kernel for their size.
+ *
+ * @param a Coefficients of the first operand, indexed by degree.
+ * @param n Number of coefficients in `a`.
+ * @param b Coefficients of the second operand, indexed by degree.
+ * @param m Number of coefficients in `b`.
+ * @param out Buffer of `n + m - 1` coefficients receiving the product (overwritten).
+ *
+ * Uses the convolution engine once the shorter operand reaches `convolutionThreshold`, and
+ * Karatsuba (with its own schoolbook cutover) below that. The engine depends on the type: FFT/NTT
+ * for double, the exact multi-prime NTT for int64_t (Karatsuba if the values are too large for
+ * it) and a single-prime NTT for ModInt.
+ */
+template <typename A>
+void multiplyCoefficients(const A *a, int n, const A *b, int m, A *out)
+{
+    if (std::min(n, m) >= multiplicationSettings().convolutionThreshold && convolve(a, n, b, m, out))
+        return;
+
+    karatsubaMultiply(a, n, b, m, out);
+}
+
+/**
+ * @brief Squares a coefficient array through the fastest kernel for its size.
+ *
+ * @param a Coefficients of the operand, indexed by degree.
+ * @param n Number of coefficients in `a` (at least one).
+ * @param out Buffer of `2n - 1` coefficients receiving the square (overwritten).
+ *
+ * Follows `multiplyCoefficients` with the square kernels: the NTT transforms the operand once (two
+ * transforms instead of three), the FFT runs on half-length transforms (`fftSquare`), and
+ * Karatsuba squares its halves down to `schoolbookSquare`, which computes each cross product once.
+ */
+template <typename A>
+void squareCoefficients(const A *a, int n, A *out)
+{
+    if (n >= multiplicationSettings().convolutionThreshold && convolveSquare(a, n, out))
+        return;
+
+    karatsubaSquare(a, n, out);
+}
+
+/**
+ * @brief Runs `tasks` independent tasks on up to `threads` threads, the calling thread included.
+ *
+ * @param tasks Number of tasks, numbered from 0.
+ * @param threads Maximum number of threads to use.
+ * @param task Callable invoked once with every task number.
+ *
+ * The workers take the next task number from a shared counter, so tasks of uneven cost balance out.
+ */
+template <typename F>
+static void runParallel(int tasks, int threads, F task)
+{
+    std::atomic<int> next(0);
+    auto worker = [&]()
+    {
+        for (int i = next++; i < tasks; i = next++)
+            task(i);
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < std::min(threads, tasks); i++)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread &thread : workers)
+        thread.join();
+}
+
+/**
+ * @brief Returns the number of threads a product of `work` coefficient (or term) products may use.
+ */
+static int threadsFor(long long work)
+{
+    const MultiplicationSettings &settings = multiplicationSettings();
+    return work >= settings.parallelThreshold ? std::max(1, settings.threads) : 1;
+}
+
+/**
+ * @brief Multiplies two coefficient arrays on several threads.
+ *
+ * @param a Coefficients of the first operand, indexed by degree.
+ * @param n Number of coefficients in `a`.
+ * @param b Coefficients of the second operand, indexed by degree.
+ * @param m Number of coefficients in `b`.
+ * @param out Buffer of `n + m - 1` coefficients receiving the product (overwritten).
+ * @param threads Maximum number of threads to use.
+ *
+ * Both operands are cut into slices of about sqrt(nm / threads) coefficients, so there are about
+ * `threads` tiles, and every tile (one slice of `a` times one slice of `b`) is multiplied by
+ * `multiplyCoefficients` into its own buffer. The tiles are then added up by ranges of output
+ * degrees, one range per thread, always in the same tile order so the result does not depend on
+ * the scheduling. Square tiles keep the subquadratic kernels efficient, which slicing a single
+ * operand would not for balanced products.
+ */
+template <typename A>
+void parallelMultiplyCoefficients(const A *a, int n, const A *b, int m, A *out, int threads)
+{
+    if (threads <= 1 || n <= 0 || m <= 0)
+    {
+        multiplyCoefficients(a, n, b, m, out);
+        return;
+    }
+
+    // slicesA * slicesB >= threads, with slices of about the same length in both operands
+    int slicesA = std::min({n, threads, (int)std::ceil(std::sqrt((double)threads * n / m))});
+    int slicesB = std::min(m, (threads + slicesA - 1) / slicesA);
+    int lengthA = (n + slicesA - 1) / slicesA;
+    int lengthB = (m + slicesB - 1) / slicesB;
+    slicesA = (n + lengthA - 1) / lengthA;
+    slicesB = (m + lengthB - 1) / lengthB;
+
+    // Tile t multiplies slice t / slicesB of a by slice t % slicesB of b
+    int tiles = slicesA * slicesB;
+    std::vector<std::vector<A>> partials(tiles);
+    std::vector<int> offsets(tiles);
+    runParallel(tiles, threads, [&](int tile)
+                {
+                    int startA = tile / slicesB * lengthA, countA = std::min(lengthA, n - startA);
+                    int startB = tile % slicesB * lengthB, countB = std::min(lengthB, m - startB);
+                    partials[tile].resize(countA + countB - 1);
+                    offsets[tile] = startA + startB;
+                    multiplyCoefficients(a + startA, countA, b + startB, countB, partials[tile].data());
+                });
+
+    int length = n + m - 1;
+    int ranges = std::min(threads, length);
+    runParallel(ranges, threads, [&](int range)
+                {
+                    int begin = (int)((long long)length * range / ranges);
+                    int end = (int)((long long)length * (range + 1) / ranges);
+                    std::fill(out + begin, out + end, A(0));
+                    for (int tile = 0; tile < tiles; tile++)
+                    {
+                        int from = std::max(begin, offsets[tile]);
+                        int to = std::min(end, offsets[tile] + (int)partials[tile].size());
+                        const A *partial = partials[tile].data() - offsets[tile];
+                        for (int i = from; i < to; i++)
+                            out[i] += partial[i];
+                    }
+                });
+}
+
+/**
+ * @brief Multiplies two coefficient vectors through `multiplyCoefficients`.
+ *
+ * @param a Coefficients of the first operand, indexed by degree.
+ * @param b Coefficients of the second operand, indexed by degree.
+ * @return The `a.size() + b.size() - 1` coefficients of the product (empty if an operand is empty).
+ */
+template <typename A>
+std::vector<A> multiplyVectors(const std::vector<A> &a, const std::vector<A> &b)
+{
+    if (a.empty() || b.empty())
+        return std::vector<A>();
+
+    std::vector<A> product(a.size() + b.size() - 1);
+    multiplyCoefficients(a.data(), (int)a.size(), b.data(), (int)b.size(), product.data());
+    return product;
+}
+
+/**
+ * @brief Squares a coefficient vector through `squareCoefficients`.
+ *
+ * @param a Coefficients of the operand, indexed by degree.
+ * @return The `2 * a.size() - 1` coefficients of the square (empty if the operand is empty).
+ */
+template <typename A>
+std::vector<A> squareVectors(const std::vector<A> &a)
+{
+    if (a.empty())
+        return std::vector<A>();
+
+    std::vector<A> square(2 * a.size() - 1);
+    squareCoefficients(a.data(), (int)a.size(), square.data());
+    return square;
+}
+
+/**
+ * @brief Multiplies two polynomials through the coefficient-array kernels.
+ *
+ * @param a The first polynomial.
+ * @param b The second polynomial.
+ * @return A new List object representing the product.
+ *
+ * Expands both operands into arrays indexed by degree, multiplies them with `multiplyCoefficients`
+ * (in the accumulator type of the coefficients, double for float) and hands the product to a List
+ * as its dense storage, which keeps it as an array or links the non-zero terms depending on the density.
+ * Large products are split across `threads` workers by `parallelMultiplyCoefficients`.
+ */
+template <typename T>
+BasicList<T> denseMultiply(const BasicList<T> &a, const BasicList<T> &b)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+    if (a.isEmpty() || b.isEmpty())
+        return BasicList<T>();
+
+    std::vector<Accumulator> x = a.getCoefficients();
+    std::vector<Accumulator> y = b.getCoefficients();
+
+    std::vector<Accumulator> product(x.size() + y.size() - 1);
+    parallelMultiplyCoefficients(x.data(), (int)x.size(), y.data(), (int)y.size(), product.data(),
+                                 threadsFor((long long)x.size() * (long long)y.size()));
+
+    BasicDensePolynomial<T> coefficients;
+    for (int degree = (int)product.size() - 1; degree >= 0; degree--)
+        coefficients.setCoefficient(degree, (T)product[degree]);
+
+    BasicList<T> result(std::move(coefficients));
+    return result;
+}
+
+/**
+ * @brief Multiplies a block of terms by a polynomial with a heap merge of the partial products (Johnson's algorithm).
+ *
+ * @param rowTerms Terms of the first operand, in descending degree order.
+ * @param begin Index of the first term of the block in `rowTerms`.
+ * @param end Index one past the last term of the block in `rowTerms`.
+ * @param columns Head of the second operand (not null).
+ * @return A new List object with the product of the block and the second operand.
+ *
+ * Every term of the block starts a row that walks the second operand. A max-heap keyed by product
+ * degree holds the next product of each row, so products come out in descending degree order: like
+ * terms are summed as they are popped and each finished degree is appended to the tail of the result.
+ * Only reads the nodes, so several blocks may be multiplied concurrently.
+ */
+template <typename T>
+static BasicList<T> heapMultiply(const std::vector<BasicNode<T> *> &rowTerms, int begin, int end,
+                                 const BasicNode<T> *columns)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+    using Node = BasicNode<T>;
+
+    BasicList<T> result;
+    std::vector<const Node *> cursors(end - begin, columns);
+
+    // (product degree, row index); std::priority_queue is a max-heap on the degree. The degrees are
+    // summed in int64_t, so two large exponents cannot wrap around (see `operator*`)
+    std::vector<std::pair<int64_t, int>> storage;
+    storage.reserve(end - begin);
+    std::priority_queue<std::pair<int64_t, int>> heap(std::less<std::pair<int64_t, int>>(), std::move(storage));
+    for (int row = begin; row < end; row++)
+        heap.push({(int64_t)rowTerms[row]->getDegree() + columns->getDegree(), row});
+
+    int64_t degree = heap.top().first;
+    Accumulator sum(0);
+    while (!heap.empty())
+    {
+        std::pair<int64_t, int> top = heap.top();
+        heap.pop();
+
+        if (top.first != degree)
+        {
+            T coeff = (T)sum;
+            if (coeff != T(0))
+                result.append(coeff, (int)degree);
+            degree = top.first;
+            sum = Accumulator(0);
+        }
+
+        int row = top.second;
+        const Node *&cursor = cursors[row - begin];
+        sum += (Accumulator)rowTerms[row]->getCoefficient() * (Accumulator)cursor->getCoefficient();
+
+        cursor = cursor->getNext();
+        if (cursor != nullptr)
+            heap.push({(int64_t)rowTerms[row]->getDegree() + cursor->getDegree(), row});
+    }
+
+    T coeff = (T)sum;
+    if (coeff != T(0))
+        result.append(coeff, (int)degree);
+
+    return result;
+}
+
+/**
+ * @brief Multiplies two sparse polynomials with a heap merge of the partial products (Johnson's algorithm).
+ *
+ * @param a The first polynomial.
+ * @param b The second polynomial.
+ * @return A new List object representing the product.
+ *
+ * Every term of the operand with fewer terms starts a row of `heapMultiply`. The cost is
+ * O(nm log n) time for n <= m terms, with O(n) extra memory besides the result, independently of
+ * the degrees. Large products split the rows into one block per thread; the partial products are
+ * then added up pairwise, with the pairs of each round merged in parallel.
+ */
+template <typename T>
+BasicList<T> sparseMultiply(const BasicList<T> &a, const BasicList<T> &b)
+{
+    using Node = BasicNode<T>;
+
+    if (a.isEmpty() || b.isEmpty())
+        return BasicList<T>();
+
+    const BasicList<T> &rows = a.size() <= b.size() ? a : b;
+    const BasicList<T> &columns = a.size() <= b.size() ? b : a;
+
+    // The node views of dense operands are built here, before any worker reads them
+    std::vector<Node *> rowTerms;
+    rowTerms.reserve(rows.size());
+    for (Node *current = rows.getHead(); current != nullptr; current = current->getNext())
+        rowTerms.push_back(current);
+    const Node *columnHead = columns.getHead();
+
+    int count = (int)rowTerms.size();
+    int threads = std::min(count, threadsFor((long long)a.size() * (long long)b.size()));
+    if (threads <= 1)
+        return heapMultiply(rowTerms, 0, count, columnHead);
+
+    std::vector<BasicList<T>> partials(threads);
+    runParallel(threads, threads, [&](int block)
+                {
+                    int begin = (int)((long long)count * block / threads);
+                    int end = (int)((long long)count * (block + 1) / threads);
+                    partials[block] = heapMultiply(rowTerms, begin, end, columnHead);
+                });
+
+    for (int step = 1; step < threads; step *= 2)
+    {
+        int pairs = (threads + 2 * step - 1) / (2 * step);
+        runParallel(pairs, threads, [&](int pair)
+                    {
+                        int left = 2 * step * pair;
+                        int right = left + step;
+                        if (right < threads)
+                        {
+                            partials[left] += partials[right];
+                            partials[right] = BasicList<T>();
+                        }
+                    });
+    }
+
+    return std::move(partials[0]);
+}
+
+template bool isDense(const BasicList<float> &poly);
+template bool isDense(const BasicList<double> &poly);
+template bool isDense(const BasicList<int64_t> &poly);
+template bool isDense(const BasicList<ModInt> &poly);
+
+template void schoolbookMultiply(const double *a, int n, const double *b, int m, double *out);
+template void schoolbookMultiply(const int64_t *a, int n, const int64_t *b, int m, int64_t *out);
+template void schoolbookMultiply(const ModInt *a, int n, const ModInt *b, int m, ModInt *out);
+
+template void schoolbookSquare(const double *a, int n, double *out);
+template void schoolbookSquare(const int64_t *a, int n, int64_t *out);
+template void schoolbookSquare(const ModInt *a, int n, ModInt *out);
+
+template void karatsubaMultiply(const double *a, int n, const double *b, int m, double *out);
+template void karatsubaMultiply(const int64_t *a, int n, const int64_t *b, int m, int64_t *out);
+template void karatsubaMultiply(const ModInt *a, int n, const ModInt *b, int m, ModInt *out);
+
+template void karatsubaSquare(const double *a, int n, double *out);
+template void karatsubaSquare(const int64_t *a, int n, int64_t *out);
+template void karatsubaSquare(const ModInt *a, int n, ModInt *out);
+
+template void multiplyCoefficients(const double *a, int n, const double *b, int m, double *out);
+template void multiplyCoefficients(const int64_t *a, int n, const int64_t *b, int m, int64_t *out);
+template void multiplyCoefficients(const ModInt *a, int n, const ModInt *b, int m, ModInt *out);
+
+template void squareCoefficients(const double *a, int n, double *out);
+template void squareCoefficients(const int64_t *a, int n, int64_t *out);
+template void squareCoefficients(const ModInt *a, int n, ModInt *out);
+
+template void parallelMultiplyCoefficients(const double *a, int n, const double *b, int m, double *out, int threads);
+template void parallelMultiplyCoefficients(const int64_t *a, int n, const int64_t *b, int m, int64_t *out, int threads);
+template void parallelMultiplyCoefficients(const ModInt *a, int n, const ModInt *b, int m, ModInt *out, int threads);
+
+template std::vector<double> multiplyVectors(const std::vector<double> &a, const std::vector<double> &b);
+template std::vector<int64_t> multiplyVectors(const std::vector<int64_t> &a, const std::vector<int64_t> &b);
+template std::vector<ModInt> multiplyVectors(const std::vector<ModInt> &a, const std::vector<ModInt> &b);
+
+template std::vector<double> squareVectors(const std::vector<double> &a);
+template std::vector<int64_t> squareVectors(const std::vector<int64_t> &a);
+template std::vector<ModInt> squareVectors(const std::vector<ModInt> &a);
+
+template BasicList<float> denseMultiply(const BasicList<float> &a, const BasicList<float> &b);
+template BasicList<double> denseMultiply(const BasicList<double> &a, const BasicList<double> &b);
+template BasicList<int64_t> denseMultiply(const BasicList<int64_t> &a, const BasicList<int64_t> &b);
+template BasicList<ModInt> denseMultiply(const BasicList<ModInt> &a, const BasicList<ModInt> &b);
+
+template BasicList<float> sparseMultiply(const BasicList<float> &a, const BasicList<float> &b);
+template BasicList<double> sparseMultiply(const BasicList<double> &a, const BasicList<double> &b);
+template BasicList<int64_t> sparseMultiply(const BasicList<int64_t> &a, const BasicList<int64_t> &b);
+template BasicList<ModInt> sparseMultiply(const BasicList<ModInt> &a, const BasicList<ModInt> &b);
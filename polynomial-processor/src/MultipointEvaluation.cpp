@@ -0,0 +1,167 @@
+#include "../include/MultipointEvaluation.h"
+#include "../include/Division.h"
+#include "../include/Multiplication.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Returns the settings shared by every multipoint evaluation.
+ *
+ * @return Reference to the process-wide MultipointSettings object, which may be tuned at startup.
+ */
+MultipointSettings &multipointSettings()
+{
+    static MultipointSettings settings;
+    return settings;
+}
+
+/**
+ * @brief Subproduct tree over a set of points, in the accumulator type of the coefficients.
+ *
+ * Node `i` holds the product of (x - x_j) over its range of points; its children are `2i + 1`
+ * and `2i + 2`. Ranges of at most `crossover` points are leaves.
+ */
+template <typename A>
+struct SubproductTree
+{
+    std::vector<std::vector<A>> products;
+    const A *points;
+    size_t crossover;
+
+    SubproductTree(const A *xs, size_t n, size_t leafSize)
+        : points(xs), crossover(leafSize)
+    {
+        size_t nodes = 1;
+        while (nodes < 2 * ((n + leafSize - 1) / leafSize))
+            nodes <<= 1;
+        products.resize(2 * nodes);
+        build(0, 0, n);
+    }
+
+    void build(size_t node, size_t begin, size_t end)
+    {
+        if (end - begin <= crossover)
+        {
+            // Product of a few linear factors, built incrementally
+            std::vector<A> &product = products[node];
+            product.assign(1, A(1));
+            for (size_t i = begin; i < end; i++)
+            {
+                product.push_back(A(0));
+                for (size_t j = product.size() - 1; j > 0; j--)
+                    product[j] = product[j - 1] - points[i] * product[j];
+                product[0] = product[0] * -points[i];
+            }
+            return;
+        }
+
+        size_t middle = begin + (end - begin) / 2;
+        build(2 * node + 1, begin, middle);
+        build(2 * node + 2, middle, end);
+        products[node] = multiplyVectors(products[2 * node + 1], products[2 * node + 2]);
+    }
+
+    void evaluate(size_t node, size_t begin, size_t end, const std::vector<A> &poly, A *out) const
+    {
+        if (end - begin <= crossover)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                A value(0);
+                for (size_t j = poly.size(); j-- > 0;)
+                    value = value * points[i] + poly[j];
+                out[i] = value;
+            }
+            return;
+        }
+
+        size_t middle = begin + (end - begin) / 2;
+        std::vector<A> quotient, remainder;
+
+        divideCoefficients(poly, products[2 * node + 1], quotient, remainder);
+        evaluate(2 * node + 1, begin, middle, remainder, out);
+
+        divideCoefficients(poly, products[2 * node + 2], quotient, remainder);
+        evaluate(2 * node + 2, middle, end, remainder, out);
+    }
+};
+
+/**
+ * @brief Helper that runs the subproduct-tree evaluation, or `evaluateMany` where the tree does not pay off.
+ */
+template <typename T>
+static void treeEvaluate(const BasicList<T> &poly, const T *xs, T *out, size_t n)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+    const MultipointSettings &settings = multipointSettings();
+    size_t crossover = settings.crossover > 0 ? (size_t)settings.crossover : 1;
+
+    // Exact ModInt remainders need no bound; floating-point ones lose precision as the products grow
+    bool trusted = true;
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        double growth = 0.0;
+        for (size_t i = 0; i < n; i++)
+            growth += std::log2(1.0 + std::fabs(xs[i]));
+        trusted = growth <= std::log2(settings.maxProductGrowth);
+    }
+
+    // The tree costs about as much for a few terms as for n, so it needs both many points and many terms
+    size_t minPoints = (size_t)std::max(settings.minPoints, 0);
+    if (n < minPoints || n <= crossover || (size_t)poly.size() < minPoints || (size_t)poly.size() <= crossover ||
+        !isDense(poly) || !trusted)
+    {
+        poly.evaluateMany(xs, out, n);
+        return;
+    }
+
+    std::vector<Accumulator> coefficients = poly.getCoefficients();
+
+    std::vector<Accumulator> points(xs, xs + n);
+    std::vector<Accumulator> values(n);
+    SubproductTree<Accumulator> tree(points.data(), n, crossover);
+
+    std::vector<Accumulator> quotient, remainder;
+    divideCoefficients(coefficients, tree.products[0], quotient, remainder);
+    tree.evaluate(0, 0, n, remainder, values.data());
+
+    for (size_t i = 0; i < n; i++)
+        out[i] = (T)values[i];
+}
+
+/**
+ * @brief Evaluates a polynomial at n points through a subproduct tree and recursive remaindering.
+ *
+ * @param poly The polynomial to evaluate.
+ * @param xs Array of `n` points.
+ * @param out Array of `n` values receiving p(xs[i]).
+ * @param n The number of points.
+ *
+ * Builds the tree of products of (x - x_i) bottom-up with the fast multiplication kernels, reduces
+ * the polynomial modulo the root and then modulo each child down the tree with the Newton-based
+ * division, so the total cost is O(M(n) log n), about O(n log^2 n). Nodes with at most `crossover`
+ * points evaluate their (small) remainder with Horner's rule. Below `minPoints` points or terms, or
+ * for sparse polynomials that cannot be expanded into a coefficient array, the whole call is
+ * `evaluateMany`.
+ *
+ * @note ModInt remainders are exact, so the tree is always trusted for them. Floating-point ones run
+ *       in double precision, and the coefficients of a product of many linear factors can grow up
+ *       to prod(1 + |x_i|), which quickly swamps the precision of the remainders: when that bound
+ *       exceeds `maxProductGrowth` the call falls back to `evaluateMany`. int64_t polynomials are
+ *       always evaluated with `evaluateMany`, since the products overflow long before the tree pays off.
+ */
+template <typename T>
+void multipointEvaluate(const BasicList<T> &poly, const T *xs, T *out, size_t n)
+{
+    if constexpr (std::is_same<T, int64_t>::value)
+        poly.evaluateMany(xs, out, n);
+    else
+        treeEvaluate(poly, xs, out, n);
+}
+
+template void multipointEvaluate(const BasicList<float> &poly, const float *xs, float *out, size_t n);
+template void multipointEvaluate(const BasicList<double> &poly, const double *xs, double *out, size_t n);
+template void multipointEvaluate(const BasicList<int64_t> &poly, const int64_t *xs, int64_t *out, size_t n);
+template void multipointEvaluate(const BasicList<ModInt> &poly, const ModInt *xs, ModInt *out, size_t n);
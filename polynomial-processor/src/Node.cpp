@@ -1,10 +1,19 @@
 #include "../include/Node.h"
 
 // Constructor
-Node::Node(float coeff, int deg)
+template <typename T>
+BasicNode<T>::BasicNode(T coeff, int deg)
     : coefficient(coeff), degree(deg), next(nullptr) {}
 
 // Getters
-float Node::getCoefficient() const { return coefficient; }
-int Node::getDegree() const { return degree; }
-Node *Node::getNext() const { return next; }
+template <typename T>
+T BasicNode<T>::getCoefficient() const { return coefficient; }
+template <typename T>
+int BasicNode<T>::getDegree() const { return degree; }
+template <typename T>
+BasicNode<T> *BasicNode<T>::getNext() const { return next; }
+
+template class BasicNode<float>;
+template class BasicNode<double>;
+template class BasicNode<int64_t>;
+template class BasicNode<ModInt>;
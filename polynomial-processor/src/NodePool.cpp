@@ -0,0 +1,306 @@
+#include "../include/NodePool.h"
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @class BasicNodePool
+ * @brief Arena that hands out the nodes of one List.
+ *
+ * Nodes are carved out of chunks that grow geometrically from `MIN_CHUNK` to `MAX_CHUNK` nodes, so a
+ * list of n terms costs O(log n) heap allocations instead of n, and consecutive terms end up next to
+ * each other in memory. Removed nodes go to a free list and are reused before the chunk is bumped.
+ * Every node is released in bulk when the pool is reset or destroyed.
+ */
+
+// Shared by the pools of every coefficient type; bumped once per chunk
+static std::atomic<std::size_t> heapAllocations{0};
+
+/**
+ * @brief Number of nodes created by one thread, registered so `nodeCount` can sum every thread.
+ *
+ * Only the owning thread writes its counter, with a plain relaxed store, so `create` never writes
+ * to a cache line shared with other threads; the atomic only lets `nodeCount` read it meanwhile.
+ * A thread that exits adds its count to the total of the exited threads.
+ */
+struct NodeCounter
+{
+    std::atomic<std::size_t> nodes{0};
+
+    NodeCounter();
+    ~NodeCounter();
+};
+
+// Counters of the running threads, and the nodes created by the threads that have exited
+struct NodeCounters
+{
+    std::mutex mutex;
+    std::vector<const NodeCounter *> running;
+    std::size_t exited = 0;
+};
+
+static NodeCounters &nodeCounters()
+{
+    static NodeCounters counters;
+    return counters;
+}
+
+NodeCounter::NodeCounter()
+{
+    NodeCounters &counters = nodeCounters();
+    std::lock_guard<std::mutex> lock(counters.mutex);
+    counters.running.push_back(this);
+}
+
+NodeCounter::~NodeCounter()
+{
+    NodeCounters &counters = nodeCounters();
+    std::lock_guard<std::mutex> lock(counters.mutex);
+    counters.exited += nodes.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < counters.running.size(); i++)
+    {
+        if (counters.running[i] == this)
+        {
+            counters.running[i] = counters.running.back();
+            counters.running.pop_back();
+            break;
+        }
+    }
+}
+
+// Nodes created on the calling thread, so a command can count its own allocations
+static thread_local NodeCounter threadNodes;
+
+/**
+ * @brief Default constructor that initializes a pool without any chunk.
+ */
+template <typename T>
+BasicNodePool<T>::BasicNodePool()
+    : chunks(nullptr), freeList(nullptr), cursor(nullptr), limit(nullptr), nextCapacity(MIN_CHUNK) {}
+
+/**
+ * @brief Destructor that frees every chunk (and therefore every node) at once.
+ */
+template <typename T>
+BasicNodePool<T>::~BasicNodePool()
+{
+    release();
+}
+
+/**
+ * @brief Move constructor that takes over every chunk of another pool.
+ *
+ * @param other The pool to move from; it is left empty.
+ *
+ * Nodes keep their addresses, so lists built on `other` stay valid under the new owner.
+ */
+template <typename T>
+BasicNodePool<T>::BasicNodePool(BasicNodePool &&other) noexcept
+    : chunks(other.chunks), freeList(other.freeList), cursor(other.cursor), limit(other.limit),
+      nextCapacity(other.nextCapacity)
+{
+    other.chunks = nullptr;
+    other.freeList = nullptr;
+    other.cursor = other.limit = nullptr;
+    other.nextCapacity = MIN_CHUNK;
+}
+
+/**
+ * @brief Move assignment operator that frees the current chunks and takes over those of another pool.
+ *
+ * @param other The pool to move from; it is left empty.
+ * @return Reference to the assigned pool.
+ */
+template <typename T>
+BasicNodePool<T> &BasicNodePool<T>::operator=(BasicNodePool &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    release();
+    std::swap(chunks, other.chunks);
+    std::swap(freeList, other.freeList);
+    std::swap(cursor, other.cursor);
+    std::swap(limit, other.limit);
+    std::swap(nextCapacity, other.nextCapacity);
+    return *this;
+}
+
+/**
+ * @brief Constructs a node inside the pool.
+ *
+ * @param coefficient The coefficient of the new node.
+ * @param degree The degree of the new node.
+ * @return Pointer to the new node, owned by the pool.
+ */
+template <typename T>
+BasicNode<T> *BasicNodePool<T>::create(T coefficient, int degree)
+{
+    Node *slot;
+    if (freeList != nullptr)
+    {
+        slot = freeList;
+        freeList = freeList->next;
+    }
+    else
+    {
+        if (cursor == limit)
+            addChunk(nextCapacity);
+        slot = cursor++;
+    }
+
+    threadNodes.nodes.store(threadNodes.nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return new (slot) Node(coefficient, degree);
+}
+
+/**
+ * @brief Returns a node to the pool so its slot can be reused.
+ *
+ * @param node The node to release; it must have been created by this pool.
+ */
+template <typename T>
+void BasicNodePool<T>::destroy(Node *node)
+{
+    node->next = freeList;
+    freeList = node;
+}
+
+/**
+ * @brief Makes sure the next `count` nodes can be created without another heap allocation.
+ *
+ * @param count The number of nodes about to be created.
+ */
+template <typename T>
+void BasicNodePool<T>::reserve(std::size_t count)
+{
+    std::size_t available = (std::size_t)(limit - cursor);
+    for (Node *node = freeList; node != nullptr && available < count; node = node->next)
+        available++;
+
+    if (available < count)
+        addChunk(count - available);
+}
+
+/**
+ * @brief Releases every node at once while keeping the most recent chunk for reuse.
+ *
+ * The kept chunk is the last one allocated: while the chunks grow geometrically it is the
+ * largest, holding about half the nodes of the pool, but after a `reserve` it is the chunk that
+ * call added, whatever its size. The next chunks grow from its capacity.
+ */
+template <typename T>
+void BasicNodePool<T>::reset()
+{
+    if (chunks == nullptr)
+        return;
+
+    Chunk *kept = chunks;
+    chunks = chunks->next;
+    release();
+
+    kept->next = nullptr;
+    chunks = kept;
+    cursor = firstSlot(kept);
+    limit = cursor + kept->capacity;
+    nextCapacity = kept->capacity < MAX_CHUNK ? kept->capacity * 2 : MAX_CHUNK;
+}
+
+/**
+ * @brief Frees every chunk and returns the pool to its initial state.
+ */
+template <typename T>
+void BasicNodePool<T>::release()
+{
+    while (chunks != nullptr)
+    {
+        Chunk *next = chunks->next;
+        ::operator delete(chunks);
+        chunks = next;
+    }
+    freeList = nullptr;
+    cursor = limit = nullptr;
+    nextCapacity = MIN_CHUNK;
+}
+
+/**
+ * @brief Retrieves the number of heap allocations made by all pools.
+ *
+ * @return The number of chunks allocated since the program started.
+ */
+template <typename T>
+std::size_t BasicNodePool<T>::allocationCount()
+{
+    return heapAllocations.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Retrieves the number of nodes created by all pools.
+ *
+ * @return The number of calls to `create` since the program started, summed over the threads
+ *         (the counts of running threads are read as they are).
+ */
+template <typename T>
+std::size_t BasicNodePool<T>::nodeCount()
+{
+    NodeCounters &counters = nodeCounters();
+    std::lock_guard<std::mutex> lock(counters.mutex);
+    std::size_t total = counters.exited;
+    for (const NodeCounter *counter : counters.running)
+        total += counter->nodes.load(std::memory_order_relaxed);
+    return total;
+}
+
+/**
+ * @brief Retrieves the number of nodes created by all pools on the calling thread.
+ *
+ * @return The number of calls to `create` made by this thread.
+ */
+template <typename T>
+std::size_t BasicNodePool<T>::threadNodeCount()
+{
+    return threadNodes.nodes.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Helper method that allocates a new chunk and makes it the current bump region.
+ *
+ * @param capacity The number of nodes the chunk must hold.
+ *
+ * Any slot left in the previous bump region is moved to the free list so it is not lost.
+ */
+template <typename T>
+void BasicNodePool<T>::addChunk(std::size_t capacity)
+{
+    while (cursor != limit)
+        destroy(cursor++);
+
+    void *memory = ::operator new(sizeof(Chunk) + capacity * sizeof(Node));
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    Chunk *chunk = static_cast<Chunk *>(memory);
+    chunk->next = chunks;
+    chunk->capacity = capacity;
+    chunks = chunk;
+
+    cursor = firstSlot(chunk);
+    limit = cursor + capacity;
+
+    if (nextCapacity < MAX_CHUNK)
+        nextCapacity *= 2;
+}
+
+/**
+ * @brief Helper method that returns the first node slot stored after a chunk header.
+ */
+template <typename T>
+BasicNode<T> *BasicNodePool<T>::firstSlot(Chunk *chunk)
+{
+    return reinterpret_cast<Node *>(chunk + 1);
+}
+
+template class BasicNodePool<float>;
+template class BasicNodePool<double>;
+template class BasicNodePool<int64_t>;
+template class BasicNodePool<ModInt>;
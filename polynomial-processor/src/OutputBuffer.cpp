@@ -0,0 +1,168 @@
+#include "../include/OutputBuffer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+
+/**
+ * @class OutputBuffer
+ * @brief Growable character buffer that text and numbers are written into without temporary strings.
+ *
+ * Numbers are converted in place with `std::to_chars`, and the storage is kept between uses, so
+ * writing allocates only while the buffer grows. A buffer attached to a file descriptor writes its
+ * contents with one `write(2)` call every `FLUSH_SIZE` bytes (and on `flush`), instead of one call
+ * per line; a detached buffer only collects text, to be read with `view`.
+ */
+
+/**
+ * @brief Constructs an empty buffer.
+ *
+ * @param descriptor The file descriptor the contents are written to, or -1 to only collect them.
+ */
+OutputBuffer::OutputBuffer(int descriptor) : used(0), descriptor(descriptor)
+{
+    if (descriptor >= 0)
+        data.resize(FLUSH_SIZE);
+}
+
+/**
+ * @brief Destructor that writes out whatever is left in an attached buffer.
+ */
+OutputBuffer::~OutputBuffer()
+{
+    flush();
+}
+
+/**
+ * @brief Returns room for `count` more characters after the contents.
+ *
+ * @param count The number of characters about to be written.
+ * @return Pointer to the first free character.
+ *
+ * An attached buffer that would exceed its size writes its contents out first; a detached buffer
+ * (or a single text longer than the buffer) grows geometrically.
+ */
+char *OutputBuffer::reserve(std::size_t count)
+{
+    if (used + count > data.size())
+    {
+        if (descriptor >= 0 && used > 0)
+            flush();
+        if (used + count > data.size())
+            data.resize(std::max(data.size() * 2, used + count));
+    }
+    return data.data() + used;
+}
+
+/**
+ * @brief Appends a piece of text.
+ */
+OutputBuffer &OutputBuffer::operator<<(std::string_view text)
+{
+    char *first = reserve(text.size());
+    std::memcpy(first, text.data(), text.size());
+    used += text.size();
+    return *this;
+}
+
+/**
+ * @brief Appends a single character.
+ */
+OutputBuffer &OutputBuffer::operator<<(char c)
+{
+    *reserve(1) = c;
+    used++;
+    return *this;
+}
+
+/**
+ * @brief Appends raw bytes, such as the records of the binary format.
+ */
+OutputBuffer &OutputBuffer::write(const void *bytes, std::size_t count)
+{
+    char *first = reserve(count);
+    std::memcpy(first, bytes, count);
+    used += count;
+    return *this;
+}
+
+/**
+ * @brief Writes the contents to the attached descriptor and empties the buffer.
+ *
+ * Does nothing for a detached buffer. Partial writes are resumed until every byte is written.
+ */
+void OutputBuffer::flush()
+{
+    if (descriptor < 0)
+        return;
+
+    std::size_t written = 0;
+    while (written < used)
+    {
+        ssize_t count = ::write(descriptor, data.data() + written, used - written);
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            break;
+        written += count;
+    }
+    used = 0;
+}
+
+/**
+ * @brief Discards the contents, keeping the storage for the next writes.
+ */
+void OutputBuffer::clear()
+{
+    used = 0;
+}
+
+/**
+ * @brief Returns the number of characters in the buffer.
+ */
+std::size_t OutputBuffer::size() const
+{
+    return used;
+}
+
+/**
+ * @brief Returns a view of the contents, valid until the next write.
+ */
+std::string_view OutputBuffer::view() const
+{
+    return std::string_view(data.data(), used);
+}
+
+/**
+ * @brief Returns the buffer attached to the standard output.
+ *
+ * @return Reference to the process-wide buffer; it is flushed when the program exits.
+ */
+OutputBuffer &standardOutput()
+{
+    static OutputBuffer output(STDOUT_FILENO);
+    return output;
+}
+
+static thread_local std::ostream *errorStream = nullptr;
+
+/**
+ * @brief Returns the stream receiving the error messages of the calling thread.
+ *
+ * @return The stream set by `redirectErrors` on this thread, or `std::cerr`.
+ */
+std::ostream &errorOutput()
+{
+    return errorStream != nullptr ? *errorStream : std::cerr;
+}
+
+/**
+ * @brief Sends the error messages of the calling thread to a stream, such as the response to a client.
+ *
+ * @param stream The stream receiving the messages, or nullptr for `std::cerr`.
+ */
+void redirectErrors(std::ostream *stream)
+{
+    errorStream = stream;
+}
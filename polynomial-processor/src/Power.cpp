@@ -0,0 +1,160 @@
+#include "../include/Power.h"
+#include "../include/Division.h"
+#include "../include/Multiplication.h"
+#include <climits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Powers of polynomials by repeated squaring.
+ *
+ * The bits of the exponent are read from the most significant one down: every bit squares the
+ * running power, with `squareVectors`, and every set bit then multiplies it by the base, which is
+ * a short product while the power grows. A power of k thus takes about log2(k) squares, each
+ * costing about half a general product of the same size, instead of the k - 1 products of a chain
+ * of '*' commands.
+ */
+
+/**
+ * @brief Returns the constant polynomial 1, the power of exponent 0.
+ */
+template <typename T>
+static BasicList<T> unit()
+{
+    BasicList<T> one;
+    one.append(T(1), 0);
+    return one;
+}
+
+/**
+ * @brief Raises a polynomial to a power.
+ *
+ * @param p The base.
+ * @param k The exponent; p^0 is 1, even for p = 0.
+ * @param power Receives p^k.
+ * @return `false` if the degree of p^k does not fit in an int; otherwise, `true`.
+ *
+ * A sparse base is squared as a List, with the kernel `operator*` picks for it, so a power with
+ * few terms never expands into a coefficient array; once the running power is dense (see
+ * `isDense`), the remaining bits run on coefficient arrays in the accumulator type of the
+ * coefficients, through the square kernels.
+ */
+template <typename T>
+bool polynomialPower(const BasicList<T> &p, uint64_t k, BasicList<T> &power)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+
+    if (k == 0)
+    {
+        power = unit<T>();
+        return true;
+    }
+    if (p.isEmpty())
+    {
+        power = BasicList<T>();
+        return true;
+    }
+    if (p.getDegree() > 0 && k > (uint64_t)(INT_MAX / p.getDegree()))
+        return false;
+
+    // The running power starts as p itself, which is only copied if it is the result
+    int bit = 63 - __builtin_clzll(k);
+    BasicList<T> result;
+    const BasicList<T> *current = &p;
+    while (bit > 0 && !isDense(*current))
+    {
+        bit--;
+        result = *current * *current;
+        if ((k >> bit) & 1)
+            result = result * p;
+        current = &result;
+    }
+    if (bit == 0)
+    {
+        power = current == &p ? BasicList<T>(p) : std::move(result);
+        return true;
+    }
+
+    std::vector<Accumulator> x = current->getCoefficients();
+    std::vector<Accumulator> base;
+    while (bit > 0)
+    {
+        bit--;
+        x = squareVectors(x);
+        if ((k >> bit) & 1)
+        {
+            if (base.empty())
+                base = p.getCoefficients();
+            x = multiplyVectors(x, base);
+        }
+    }
+    power = BasicList<T>::fromCoefficients(x);
+    return true;
+}
+
+/**
+ * @brief Raises a polynomial to a power modulo another polynomial.
+ *
+ * @param p The base.
+ * @param k The exponent.
+ * @param m The modulus.
+ * @param power Receives p^k mod m, of degree below deg m.
+ * @return `false` if m is zero, or if a reduction does not have an integer quotient (int64_t, where
+ *         a modulus with a leading coefficient of 1 or -1 always works); otherwise, `true`.
+ *
+ * The base is reduced first, with `polynomialRemainder`, which reduces a sparse base term by term,
+ * so x^1000000000 + 1 mod x^2 + 1 never expands the base. Every square and product is then reduced
+ * as soon as it is computed, so the running power never reaches degree deg m and each step costs a
+ * square (or a short product) and a division of size deg m. The reciprocal of the modulus used by
+ * the divisions is computed once for the whole power.
+ */
+template <typename T>
+bool polynomialPowerMod(const BasicList<T> &p, uint64_t k, const BasicList<T> &m, BasicList<T> &power)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+    if (m.isEmpty())
+        return false;
+
+    BasicList<T> reduced;
+    if (!polynomialRemainder(p, m, reduced))
+        return false;
+    Modulus<Accumulator> modulus(m.getCoefficients());
+    std::vector<Accumulator> base = reduced.getCoefficients();
+
+    std::vector<Accumulator> x(1, Accumulator(1));
+    if (k > 0)
+    {
+        x = base;
+        for (int bit = 63 - __builtin_clzll(k); bit > 0 && !x.empty();)
+        {
+            bit--;
+            x = squareVectors(x);
+            if (!modulus.reduce(x))
+                return false;
+            if ((k >> bit) & 1)
+            {
+                x = multiplyVectors(x, base);
+                if (!modulus.reduce(x))
+                    return false;
+            }
+        }
+    }
+    else if (!modulus.reduce(x))
+    {
+        return false;
+    }
+
+    power = BasicList<T>::fromCoefficients(x);
+    return true;
+}
+
+template bool polynomialPower(const BasicList<float> &p, uint64_t k, BasicList<float> &power);
+template bool polynomialPower(const BasicList<double> &p, uint64_t k, BasicList<double> &power);
+template bool polynomialPower(const BasicList<int64_t> &p, uint64_t k, BasicList<int64_t> &power);
+template bool polynomialPower(const BasicList<ModInt> &p, uint64_t k, BasicList<ModInt> &power);
+
+template bool polynomialPowerMod(const BasicList<float> &p, uint64_t k, const BasicList<float> &m, BasicList<float> &power);
+template bool polynomialPowerMod(const BasicList<double> &p, uint64_t k, const BasicList<double> &m, BasicList<double> &power);
+template bool polynomialPowerMod(const BasicList<int64_t> &p, uint64_t k, const BasicList<int64_t> &m, BasicList<int64_t> &power);
+template bool polynomialPowerMod(const BasicList<ModInt> &p, uint64_t k, const BasicList<ModInt> &m, BasicList<ModInt> &power);
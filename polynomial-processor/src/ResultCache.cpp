@@ -0,0 +1,368 @@
+#include "../include/ResultCache.h"
+#include "../include/BinaryFormat.h"
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+/**
+ * @class BasicResultCache
+ * @brief Bounded least-recently-used cache of command results, keyed on the command and the hashes of its operands.
+ *
+ * Results are shared, immutable lists, so a hit hands out the cached result without copying it. The
+ * cache holds at most `maxTerms` terms over all its results; storing past that evicts the least
+ * recently used results first, and a result larger than the whole budget is not stored. Every
+ * method locks the cache, so the blocks run by `-p` share it.
+ *
+ * An operand is identified by two hashes of its terms (see `cacheOperand`), not by its terms, so
+ * the cache does not keep copies of the operands; a hit on a different operand needs a collision
+ * of both hashes, about 2^-128 for a pair of polynomials.
+ *
+ * The file form is the binary form of BinaryFormat.h: one record per entry, with the command, the
+ * two hashes of each operand as four Integer operands and the result as a Polynomial operand, from
+ * the least to the most recently used.
+ */
+
+/**
+ * @brief Returns the settings of the result caches.
+ *
+ * @return Reference to the process-wide CacheSettings object, set from the command line.
+ */
+CacheSettings &cacheSettings()
+{
+    static CacheSettings settings;
+    return settings;
+}
+
+/**
+ * @brief Returns the identity of a polynomial as a cache operand.
+ *
+ * @param p The operand.
+ * @return Its canonical hashes (BasicList::hash) with seeds 0 and 1.
+ */
+template <typename T>
+CacheOperand cacheOperand(const BasicList<T> &p)
+{
+    return CacheOperand{p.hash(), p.hash(1)};
+}
+
+/**
+ * @brief Constructs an empty cache.
+ *
+ * @param maxTerms The number of terms the cached results may hold in total.
+ */
+template <typename T>
+BasicResultCache<T>::BasicResultCache(std::size_t maxTerms) : terms(0), maxTerms(maxTerms), hits(0), misses(0) {}
+
+/**
+ * @brief Looks a result up and makes it the most recently used.
+ *
+ * @param command The command character.
+ * @param first The identity of the first operand.
+ * @param second The identity of the second operand.
+ * @return The cached result, or nullptr (counted as a miss).
+ */
+template <typename T>
+std::shared_ptr<const BasicList<T>> BasicResultCache<T>::find(char command, const CacheOperand &first, const CacheOperand &second)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(Key{command, first, second});
+    if (found == index.end())
+    {
+        misses++;
+        return nullptr;
+    }
+
+    hits++;
+    entries.splice(entries.begin(), entries, found->second);
+    return found->second->result;
+}
+
+/**
+ * @brief Stores a result as the most recently used, evicting the least recently used ones to make room.
+ *
+ * @param command The command character.
+ * @param first The identity of the first operand.
+ * @param second The identity of the second operand.
+ * @param result The result of the command on those operands.
+ */
+template <typename T>
+void BasicResultCache<T>::insert(char command, const CacheOperand &first, const CacheOperand &second, std::shared_ptr<const BasicList<T>> result)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    store(Key{command, first, second}, std::move(result));
+}
+
+/**
+ * @brief Helper method that stores a result; the caller holds the lock.
+ */
+template <typename T>
+void BasicResultCache<T>::store(const Key &key, std::shared_ptr<const BasicList<T>> result)
+{
+    // Every result counts at least one term, so the budget also bounds the number of entries
+    std::size_t resultTerms = (std::size_t)result->size() + 1;
+    if (resultTerms > maxTerms)
+        return;
+
+    // A dense list builds its linked view on first traversal; building it now keeps readers from writing to a shared list
+    result->getHead();
+
+    auto found = index.find(key);
+    if (found != index.end())
+    {
+        terms -= (std::size_t)found->second->result->size() + 1;
+        entries.erase(found->second);
+        index.erase(found);
+    }
+
+    while (!entries.empty() && terms + resultTerms > maxTerms)
+    {
+        terms -= (std::size_t)entries.back().result->size() + 1;
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+
+    entries.push_front(Entry{key, std::move(result)});
+    index[key] = entries.begin();
+    terms += resultTerms;
+}
+
+/**
+ * @brief Removes every result; the counters are kept.
+ */
+template <typename T>
+void BasicResultCache<T>::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    terms = 0;
+}
+
+/**
+ * @brief Retrieves the number of lookups that found a result.
+ */
+template <typename T>
+uint64_t BasicResultCache<T>::hitCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+/**
+ * @brief Retrieves the number of lookups that found nothing.
+ */
+template <typename T>
+uint64_t BasicResultCache<T>::missCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+/**
+ * @brief Retrieves the number of cached results.
+ */
+template <typename T>
+std::size_t BasicResultCache<T>::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+/**
+ * @brief Retrieves the number of terms of every cached result.
+ */
+template <typename T>
+std::size_t BasicResultCache<T>::termCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return terms - entries.size();
+}
+
+/**
+ * @brief Adds the entries of a cache file, as the most recently used.
+ *
+ * @param path The file written by `save`.
+ * @return `false` if the file exists but is not a cache of this coefficient type (with the reason
+ *         printed); otherwise, `true`. A missing file is an empty cache.
+ *
+ * Entries whose terms are not in strictly descending degree order are skipped, and reading
+ * stops at the first truncated entry.
+ */
+template <typename T>
+bool BasicResultCache<T>::load(const std::string &path)
+{
+    using Stored = typename BinaryCoefficient<T>::Stored;
+
+    if (::access(path.c_str(), F_OK) != 0)
+        return true;
+
+    BinaryReader reader(path);
+    const BinaryHeader *header = reader.isOpen() ? reader.header() : nullptr;
+    if (header == nullptr || header->version != BINARY_VERSION || header->byteOrder != BINARY_BYTE_ORDER ||
+        header->type != (uint8_t)CoefficientTraits<T>::TYPE || header->coefficientSize != sizeof(Stored))
+    {
+        std::cerr << "Erro: O arquivo '" << path << "' não é um cache de resultados do tipo "
+                  << CoefficientTraits<T>::NAME << "; ele será substituído." << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!reader.atEnd())
+    {
+        const BinaryCommand *record = reader.take<BinaryCommand>(1);
+        if (record == nullptr || record->operandCount != 5)
+            break;
+
+        // The four hashes, then the result
+        uint64_t hashes[4];
+        const BinaryOperand *operand = nullptr;
+        int read = 0;
+        for (; read < 4; read++)
+        {
+            operand = reader.take<BinaryOperand>(1);
+            const int64_t *value = operand != nullptr && operand->kind == BinaryOperandKind::Integer ? reader.take<int64_t>(1) : nullptr;
+            if (value == nullptr)
+                break;
+            hashes[read] = (uint64_t)*value;
+        }
+        operand = read == 4 ? reader.take<BinaryOperand>(1) : nullptr;
+        if (operand == nullptr || operand->kind != BinaryOperandKind::Polynomial)
+            break;
+        const Stored *coefficients = reader.take<Stored>(operand->count);
+        const int32_t *degrees = reader.take<int32_t>(operand->count);
+        if (coefficients == nullptr || degrees == nullptr)
+            break;
+
+        auto result = std::make_shared<BasicList<T>>();
+        result->reserve((int)operand->count);
+        bool canonical = true;
+        for (uint32_t i = 0; i < operand->count && canonical; i++)
+        {
+            T coefficient = BinaryCoefficient<T>::load(coefficients[i]);
+            canonical = degrees[i] >= 0 && (i == 0 || degrees[i] < degrees[i - 1]) && coefficient != T(0);
+            if (canonical)
+                result->append(coefficient, degrees[i]);
+        }
+        if (canonical)
+            store(Key{record->command, CacheOperand{hashes[0], hashes[1]}, CacheOperand{hashes[2], hashes[3]}}, std::move(result));
+    }
+    return true;
+}
+
+/**
+ * @brief Writes every entry to a file, replacing it.
+ *
+ * @param path The file to write; it is written under a temporary name and renamed, so an
+ *             interrupted save leaves the previous file intact.
+ * @return `false` if the file cannot be written (with the reason printed); otherwise, `true`.
+ */
+template <typename T>
+bool BasicResultCache<T>::save(const std::string &path) const
+{
+    std::string temporary = path + ".tmp";
+    int descriptor = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0)
+    {
+        std::cerr << "Erro: Não foi possível abrir o arquivo '" << temporary << "' para escrita." << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        OutputBuffer out(descriptor);
+        writeBinaryHeader<T>(out);
+        for (auto entry = entries.rbegin(); entry != entries.rend(); ++entry)
+        {
+            writeBinaryCommand(out, entry->key.command, 5, 0);
+            writeBinaryInteger(out, (int64_t)entry->key.first.hash);
+            writeBinaryInteger(out, (int64_t)entry->key.first.check);
+            writeBinaryInteger(out, (int64_t)entry->key.second.hash);
+            writeBinaryInteger(out, (int64_t)entry->key.second.check);
+            writeBinaryPolynomial(out, *entry->result);
+        }
+    }
+    ::close(descriptor);
+
+    if (std::rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        std::cerr << "Erro: Não foi possível substituir o arquivo '" << path << "'." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Holds the cache of one coefficient type, created by the first `resultCache` call.
+ */
+template <typename T>
+static std::unique_ptr<BasicResultCache<T>> &cacheInstance()
+{
+    static std::unique_ptr<BasicResultCache<T>> cache;
+    return cache;
+}
+
+/**
+ * @brief Returns the cache of results with coefficients of type T.
+ *
+ * @return Reference to the process-wide cache; the first call creates it with `cacheSettings().maxTerms`
+ *         and loads `cacheSettings().path`, if set.
+ */
+template <typename T>
+BasicResultCache<T> &resultCache()
+{
+    static std::once_flag created;
+    std::call_once(created, []()
+                   {
+                       const CacheSettings &settings = cacheSettings();
+                       cacheInstance<T>() = std::make_unique<BasicResultCache<T>>(settings.maxTerms);
+                       if (!settings.path.empty())
+                           cacheInstance<T>()->load(settings.path); });
+    return *cacheInstance<T>();
+}
+
+/**
+ * @brief Saves and reports the cache of one coefficient type, if it was used.
+ */
+template <typename T>
+static void finishResultCache(bool printStats)
+{
+    const BasicResultCache<T> *cache = cacheInstance<T>().get();
+    if (cache == nullptr)
+        return;
+
+    if (!cacheSettings().path.empty())
+        cache->save(cacheSettings().path);
+    if (printStats)
+        std::cerr << "Cache de resultados (" << CoefficientTraits<T>::NAME << "): " << cache->hitCount() << " acertos, "
+                  << cache->missCount() << " faltas, " << cache->size() << " resultados com " << cache->termCount()
+                  << " termos." << std::endl;
+}
+
+/**
+ * @brief Saves every cache that was used to `cacheSettings().path` and optionally prints their counters.
+ *
+ * @param printStats Whether to print the hits, misses and size of each cache to the error stream.
+ */
+void finishResultCaches(bool printStats)
+{
+    finishResultCache<float>(printStats);
+    finishResultCache<double>(printStats);
+    finishResultCache<int64_t>(printStats);
+    finishResultCache<ModInt>(printStats);
+}
+
+template class BasicResultCache<float>;
+template class BasicResultCache<double>;
+template class BasicResultCache<int64_t>;
+template class BasicResultCache<ModInt>;
+
+template BasicResultCache<float> &resultCache<float>();
+template BasicResultCache<double> &resultCache<double>();
+template BasicResultCache<int64_t> &resultCache<int64_t>();
+template BasicResultCache<ModInt> &resultCache<ModInt>();
+
+template CacheOperand cacheOperand(const BasicList<float> &p);
+template CacheOperand cacheOperand(const BasicList<double> &p);
+template CacheOperand cacheOperand(const BasicList<int64_t> &p);
+template CacheOperand cacheOperand(const BasicList<ModInt> &p);
@@ -0,0 +1,263 @@
+#include "../include/Server.h"
+#include "../include/FileProcessor.h"
+#include "../include/Instrumentation.h"
+#include "../include/LineReader.h"
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * Persistent mode: the same command blocks as a file, sent as requests by clients that stay connected.
+ *
+ * A request is a sequence of command blocks in the text form, ended by a line holding only
+ * `REQUEST_END`. Its response is a frame made of the header line `OK <output bytes> <error bytes>`,
+ * followed by the output of the blocks (in the `--format` of the server) and then their error
+ * messages. Each client is served by a thread of its own, which keeps its operand lists between
+ * requests, and the result caches are shared by every client; a request therefore costs only the
+ * reading and the computing of its blocks.
+ */
+
+// Set by SIGINT and SIGTERM to end the accept loop
+static volatile std::sig_atomic_t stopRequested = 0;
+
+/**
+ * @brief Signal handler that asks the server to stop accepting clients.
+ */
+static void requestStop(int)
+{
+    stopRequested = 1;
+}
+
+/**
+ * @brief Writes every byte to a descriptor, retrying partial writes.
+ *
+ * @return `false` if the descriptor was closed or failed; otherwise, `true`.
+ */
+static bool writeAll(int descriptor, std::string_view bytes)
+{
+    while (!bytes.empty())
+    {
+        ssize_t count = ::write(descriptor, bytes.data(), bytes.size());
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            return false;
+        bytes.remove_prefix((size_t)count);
+    }
+    return true;
+}
+
+/**
+ * @brief Answers the requests of one client until it disconnects.
+ *
+ * @param input The descriptor the requests are read from.
+ * @param output The descriptor the response frames are written to.
+ *
+ * The error messages of the blocks are collected for the response instead of being printed
+ * by the server. A request cut short by the end of the input is still answered, and so is one
+ * whose command throws or that stops at a block it cannot read: the results of its earlier
+ * blocks are sent with the errors, the rest of its frame is dropped, and the connection, like
+ * every other one, goes on to the next request.
+ */
+template <typename T>
+static void serveConnection(int input, int output)
+{
+    LineReader reader(input);
+    reader.setFrameEnd(REQUEST_END);
+    OutputBuffer results;
+    std::ostringstream errors;
+    redirectErrors(&errors);
+
+    while (true)
+    {
+        results.clear();
+        errors.str("");
+        {
+            SpanTimer span("request");
+            try
+            {
+                processRequest<T>(reader, results);
+            }
+            catch (const std::exception &failure)
+            {
+                errorOutput() << "Erro: Falha na requisição: " << failure.what() << std::endl;
+            }
+
+            // A request stopped by a failure or by a block it could not read leaves the rest of its
+            // lines unread; they are dropped, so the next request starts at its own frame
+            std::string_view line;
+            while (reader.next(line))
+            {
+            }
+        }
+
+        // The frame is only incomplete if the input ended inside it
+        std::string messages = errors.str();
+        bool complete = reader.atFrameEnd();
+        if (!complete && reader.lineCount() == 0 && results.size() == 0 && messages.empty())
+            break;
+
+        std::string header = "OK " + std::to_string(results.size()) + " " + std::to_string(messages.size()) + "\n";
+        if (!writeAll(output, header) || !writeAll(output, results.view()) || !writeAll(output, messages) || !complete)
+            break;
+        reader.nextFrame();
+    }
+    redirectErrors(nullptr);
+}
+
+/**
+ * @brief Listens on a Unix socket and serves each client on a thread of its own, until SIGINT or SIGTERM.
+ *
+ * @param path The path of the socket; a socket left there by an earlier run is replaced.
+ * @return `false` if the socket cannot be created; otherwise, `true` once every client is done.
+ *
+ * When stopped, the server stops accepting clients, lets the request of each connected client
+ * finish and then closes the connections.
+ */
+template <typename T>
+static bool serveSocket(const std::string &path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Erro: Caminho de socket longo demais: '" << path << "'." << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    struct stat existing;
+    if (::lstat(path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode))
+        ::unlink(path.c_str());
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 || ::bind(listener, (const sockaddr *)&address, sizeof(address)) != 0 || ::listen(listener, SOMAXCONN) != 0)
+    {
+        std::cerr << "Erro: Não foi possível escutar no socket '" << path << "': " << std::strerror(errno) << std::endl;
+        if (listener >= 0)
+            ::close(listener);
+        return false;
+    }
+
+    // Without SA_RESTART, the signals interrupt accept
+    struct sigaction action{};
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGINT, &action, nullptr);
+    ::sigaction(SIGTERM, &action, nullptr);
+
+    // The client threads block both signals, so they always reach the accept loop
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+
+    struct Connection
+    {
+        int descriptor;
+        std::atomic<bool> done{false};
+        std::thread thread;
+    };
+    std::list<std::unique_ptr<Connection>> connections;
+
+    // Joins the threads of the clients that disconnected and closes their sockets
+    auto reap = [&](bool all)
+    {
+        for (auto connection = connections.begin(); connection != connections.end();)
+        {
+            if (!all && !(*connection)->done)
+            {
+                ++connection;
+                continue;
+            }
+            if (all)
+                ::shutdown((*connection)->descriptor, SHUT_RD);
+            (*connection)->thread.join();
+            ::close((*connection)->descriptor);
+            connection = connections.erase(connection);
+        }
+    };
+
+    while (!stopRequested)
+    {
+        int client = ::accept(listener, nullptr, nullptr);
+        if (client < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            std::cerr << "Erro: Falha ao aceitar cliente: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        reap(false);
+
+        auto connection = std::make_unique<Connection>();
+        Connection *served = connection.get();
+        served->descriptor = client;
+
+        sigset_t previous;
+        pthread_sigmask(SIG_BLOCK, &stopSignals, &previous);
+        served->thread = std::thread([served]()
+                                     {
+                                         serveConnection<T>(served->descriptor, served->descriptor);
+                                         served->done = true; });
+        pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+        connections.push_back(std::move(connection));
+    }
+
+    ::close(listener);
+    ::unlink(path.c_str());
+    reap(true);
+    return true;
+}
+
+/**
+ * @brief Serves requests with polynomials of type T.
+ */
+template <typename T>
+static bool serve(const std::string &address)
+{
+    if (address == "-")
+    {
+        serveConnection<T>(STDIN_FILENO, STDOUT_FILENO);
+        return true;
+    }
+    return serveSocket<T>(address);
+}
+
+/**
+ * @brief Serves the command blocks of clients with polynomials of the given coefficient type.
+ *
+ * @param address "-" to serve a single client on the standard input and output, or the path of
+ *                a Unix socket to serve any number of clients at once.
+ * @param type The coefficient type of every request.
+ * @return `false` if the socket cannot be opened; otherwise, `true` once the server stops.
+ */
+bool serve(const std::string &address, CoefficientType type)
+{
+    // A client that disconnects before reading its response must not end the server
+    std::signal(SIGPIPE, SIG_IGN);
+
+    switch (type)
+    {
+        case CoefficientType::Float:
+            return serve<float>(address);
+        case CoefficientType::Double:
+            return serve<double>(address);
+        case CoefficientType::Int64:
+            return serve<int64_t>(address);
+        case CoefficientType::Mod:
+            return serve<ModInt>(address);
+    }
+    return false;
+}
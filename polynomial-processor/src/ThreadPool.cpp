@@ -0,0 +1,137 @@
+#include "../include/ThreadPool.h"
+#include <utility>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads with one work-stealing task queue each.
+ *
+ * A task submitted from a worker goes to the back of that worker's own queue; a task submitted
+ * from any other thread goes to the queues in turn. Every worker runs the newest task of its own
+ * queue first, which keeps related data in its cache, and when its queue is empty it steals the
+ * oldest task of another queue. Idle workers sleep on a condition variable until a task is submitted.
+ */
+
+// Pool and queue index of the current thread, if it is a worker
+static thread_local const ThreadPool *currentPool = nullptr;
+static thread_local int currentIndex = -1;
+
+/**
+ * @brief Starts the worker threads.
+ *
+ * @param threads Number of workers (at least one is started).
+ */
+ThreadPool::ThreadPool(int threads) : pending(0), nextQueue(0), stopping(false)
+{
+    int count = threads > 0 ? threads : 1;
+    for (int i = 0; i < count; i++)
+        queues.push_back(std::make_unique<Queue>());
+    for (int i = 0; i < count; i++)
+        workers.emplace_back(&ThreadPool::run, this, i);
+}
+
+/**
+ * @brief Runs every task still queued, then stops and joins the workers.
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+/**
+ * @brief Queues a task.
+ *
+ * @param task The task to run on one of the workers.
+ * @return A future that becomes ready when the task has run (and rethrows its exception, if any).
+ */
+std::future<void> ThreadPool::submit(std::function<void()> task)
+{
+    auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    std::future<void> done = packaged->get_future();
+
+    // Counted first, so `pending` never drops below the number of queued tasks
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pending++;
+    }
+    std::size_t index = currentPool == this ? (std::size_t)currentIndex : nextQueue++ % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.emplace_back([packaged]() { (*packaged)(); });
+    }
+    wake.notify_one();
+    return done;
+}
+
+/**
+ * @brief Returns the number of worker threads.
+ */
+int ThreadPool::size() const
+{
+    return (int)workers.size();
+}
+
+/**
+ * @brief Takes the newest task of a worker's own queue, or else steals the oldest task of another queue.
+ *
+ * @param index The queue of the worker.
+ * @param task Receives the task.
+ * @return `true` if a task was taken; otherwise, `false`.
+ */
+bool ThreadPool::take(int index, std::function<void()> &task)
+{
+    int count = (int)queues.size();
+    for (int offset = 0; offset < count; offset++)
+    {
+        Queue &queue = *queues[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+
+        if (offset == 0)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        pending--;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Main loop of a worker: runs tasks until the pool stops and no task is left.
+ *
+ * @param index The queue owned by the worker.
+ */
+void ThreadPool::run(int index)
+{
+    currentPool = this;
+    currentIndex = index;
+
+    std::function<void()> task;
+    while (true)
+    {
+        if (take(index, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return pending > 0 || stopping; });
+        if (stopping && pending == 0)
+            return;
+    }
+}
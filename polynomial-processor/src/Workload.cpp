@@ -0,0 +1,195 @@
+#include "../include/Workload.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+/**
+ * @brief Converts a drawn real number to a coefficient, rounding it for the integer types.
+ */
+template <typename T>
+static T fromReal(double value)
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return T(value);
+    else
+        return T((int64_t)std::llround(value));
+}
+
+/**
+ * @brief Draws one non-zero coefficient from the distribution of the spec.
+ *
+ * @param spec The workload spec.
+ * @param random The generator the coefficient is drawn with.
+ * @return The coefficient; zeros (after rounding) are drawn again.
+ */
+template <typename T>
+static T drawCoefficient(const WorkloadSpec &spec, std::mt19937_64 &random)
+{
+    std::uniform_real_distribution<double> uniform(-1000.0, 1000.0);
+    std::uniform_int_distribution<int> small(-9, 9);
+    std::normal_distribution<double> normal(0.0, 100.0);
+
+    while (true)
+    {
+        T coefficient(0);
+        switch (spec.distribution)
+        {
+            case CoefficientDistribution::Uniform:
+                coefficient = fromReal<T>(uniform(random));
+                break;
+            case CoefficientDistribution::SmallIntegers:
+                coefficient = T((int64_t)small(random));
+                break;
+            case CoefficientDistribution::Normal:
+                coefficient = fromReal<T>(normal(random));
+                break;
+        }
+        if (coefficient != T(0))
+            return coefficient;
+    }
+}
+
+/**
+ * @brief Draws a polynomial with the degree, density and coefficient distribution of a spec.
+ *
+ * @param spec The workload spec.
+ * @param random The generator the terms are drawn with.
+ * @return The polynomial, built by appending its terms from the leading one down.
+ *
+ * The leading term is always present, so the degree is exactly `spec.degree`; every lower degree
+ * has a term with probability `spec.density`.
+ */
+template <typename T>
+BasicList<T> generatePolynomial(const WorkloadSpec &spec, std::mt19937_64 &random)
+{
+    std::bernoulli_distribution present(std::min(1.0, std::max(0.0, spec.density)));
+
+    BasicList<T> poly;
+    poly.reserve((int)(spec.degree * spec.density) + 1);
+    poly.append(drawCoefficient<T>(spec, random), spec.degree);
+    for (int degree = spec.degree - 1; degree >= 0; degree--)
+    {
+        if (present(random))
+            poly.append(drawCoefficient<T>(spec, random), degree);
+    }
+    return poly;
+}
+
+/**
+ * @brief Draws evaluation points.
+ *
+ * @param count The number of points.
+ * @param random The generator the points are drawn with.
+ * @return Points in [-1, 1]; -1, 0 or 1 for the integer types, so values of high degree do not overflow.
+ */
+template <typename T>
+std::vector<T> generatePoints(std::size_t count, std::mt19937_64 &random)
+{
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    std::vector<T> points(count);
+    for (T &x : points)
+        x = fromReal<T>(uniform(random));
+    return points;
+}
+
+/**
+ * @brief Writes a synthetic command file.
+ *
+ * @param out The buffer receiving the file.
+ * @param spec The shape of every polynomial of the file; the generator is seeded with `spec.seed`.
+ * @param blocks The number of command blocks.
+ *
+ * The blocks cycle through `+`, `-`, `*`, `P`, `G`, `T`, `A`, `V`, `B` and `E` (with the expression
+ * `a + b * c`), so a run of the file exercises every command; `V` and `B` evaluate 16 points.
+ * Coefficients are written in their shortest exact form.
+ */
+template <typename T>
+void writeWorkload(OutputBuffer &out, const WorkloadSpec &spec, int blocks)
+{
+    static constexpr char COMMANDS[] = {'+', '-', '*', 'P', 'G', 'T', 'A', 'V', 'B', 'E'};
+    static constexpr int POINTS = 16;
+
+    std::mt19937_64 random(spec.seed);
+    auto writePolynomial = [&]()
+    {
+        generatePolynomial<T>(spec, random).formatPairs(out);
+        out << '\n';
+    };
+
+    for (int block = 0; block < blocks; block++)
+    {
+        char command = COMMANDS[block % (sizeof(COMMANDS) / sizeof(COMMANDS[0]))];
+        out << command << '\n';
+        switch (command)
+        {
+            case '+':
+            case '-':
+            case '*':
+                writePolynomial();
+                writePolynomial();
+                break;
+            case 'A':
+                out.writeExact(generatePoints<T>(1, random)[0]) << '\n';
+                writePolynomial();
+                break;
+            case 'V':
+            case 'B':
+            {
+                std::vector<T> points = generatePoints<T>(POINTS, random);
+                for (int i = 0; i < POINTS; i++)
+                {
+                    if (i > 0)
+                        out << ' ';
+                    out.writeExact(points[i]);
+                }
+                out << '\n';
+                writePolynomial();
+                break;
+            }
+            case 'E':
+                out << "a + b * c\n";
+                writePolynomial();
+                writePolynomial();
+                writePolynomial();
+                break;
+            default:
+                writePolynomial();
+        }
+    }
+}
+
+/**
+ * @brief Parses the name of a coefficient distribution.
+ *
+ * @param name The name given on the command line: "uniform", "integers" or "normal".
+ * @param distribution Receives the parsed distribution on success.
+ * @return `true` if the name is known; otherwise, `false`.
+ */
+bool parseCoefficientDistribution(const std::string &name, CoefficientDistribution &distribution)
+{
+    if (name == "uniform")
+        distribution = CoefficientDistribution::Uniform;
+    else if (name == "integers")
+        distribution = CoefficientDistribution::SmallIntegers;
+    else if (name == "normal")
+        distribution = CoefficientDistribution::Normal;
+    else
+        return false;
+    return true;
+}
+
+template BasicList<float> generatePolynomial(const WorkloadSpec &spec, std::mt19937_64 &random);
+template BasicList<double> generatePolynomial(const WorkloadSpec &spec, std::mt19937_64 &random);
+template BasicList<int64_t> generatePolynomial(const WorkloadSpec &spec, std::mt19937_64 &random);
+template BasicList<ModInt> generatePolynomial(const WorkloadSpec &spec, std::mt19937_64 &random);
+
+template std::vector<float> generatePoints(std::size_t count, std::mt19937_64 &random);
+template std::vector<double> generatePoints(std::size_t count, std::mt19937_64 &random);
+template std::vector<int64_t> generatePoints(std::size_t count, std::mt19937_64 &random);
+template std::vector<ModInt> generatePoints(std::size_t count, std::mt19937_64 &random);
+
+template void writeWorkload<float>(OutputBuffer &out, const WorkloadSpec &spec, int blocks);
+template void writeWorkload<double>(OutputBuffer &out, const WorkloadSpec &spec, int blocks);
+template void writeWorkload<int64_t>(OutputBuffer &out, const WorkloadSpec &spec, int blocks);
+template void writeWorkload<ModInt>(OutputBuffer &out, const WorkloadSpec &spec, int blocks);
@@ -0,0 +1,43 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <iostream>
+
+// Counters of the checks of one test program
+struct CheckCounts
+{
+    int checks = 0;
+    int failures = 0;
+};
+
+// Returns the counters shared by every check of the program
+inline CheckCounts &checkCounts()
+{
+    static CheckCounts counts;
+    return counts;
+}
+
+// Records a check, printing it with its location if it failed; returns the condition
+inline bool check(bool condition, const char *text, const char *file, int line)
+{
+    CheckCounts &counts = checkCounts();
+    counts.checks++;
+    if (!condition)
+    {
+        counts.failures++;
+        std::cerr << file << ":" << line << ": Falha: " << text << std::endl;
+    }
+    return condition;
+}
+
+// Prints the summary of the program and returns its exit status
+inline int finishChecks(const char *name)
+{
+    const CheckCounts &counts = checkCounts();
+    std::cout << name << ": " << counts.checks << " verificações, " << counts.failures << " falhas" << std::endl;
+    return counts.failures == 0 ? 0 : 1;
+}
+
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+#endif // CHECK_H
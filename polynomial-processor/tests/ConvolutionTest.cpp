@@ -0,0 +1,228 @@
+#include "../include/Convolution.h"
+#include "../include/Multiplication.h"
+#include "Check.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/**
+ * Checks of the FFT and NTT kernels against the schoolbook product: the complex FFT (product and
+ * half-length square) within rounding, the multi-prime NTT exactly for int64_t and integer-valued
+ * doubles (and its refusal of products past the int64_t range), the single-prime NTT modulo each
+ * of `NTT_PRIMES`, and the ModInt product through
+ * `multiplyVectors`, including one longer than a single transform allows.
+ */
+
+static std::mt19937_64 generator(2024);
+
+/**
+ * @brief Returns `n` random integers in [-limit, limit].
+ */
+static std::vector<int64_t> randomIntegers(int n, int64_t limit)
+{
+    std::vector<int64_t> values(n);
+    for (int64_t &value : values)
+        value = (int64_t)(generator() % (uint64_t)(2 * limit + 1)) - limit;
+    return values;
+}
+
+/**
+ * @brief Multiplies two arrays with the schoolbook method, in the arithmetic of their type.
+ */
+template <typename A>
+static std::vector<A> schoolbook(const std::vector<A> &a, const std::vector<A> &b)
+{
+    std::vector<A> product(a.size() + b.size() - 1, A(0));
+    for (size_t i = 0; i < a.size(); i++)
+        for (size_t j = 0; j < b.size(); j++)
+            product[i + j] += a[i] * b[j];
+    return product;
+}
+
+// Operand lengths: tiny, unbalanced, around powers of two, and past the convolution thresholds
+static const int SHAPES[][2] = {{1, 1}, {1, 700}, {3, 5}, {31, 33}, {512, 512}, {513, 1000}, {2048, 2047}, {3000, 1}};
+
+/**
+ * @brief The complex FFT on integer-valued operands, which it must round to the exact product.
+ */
+static void checkFft()
+{
+    for (const auto &shape : SHAPES)
+    {
+        std::vector<int64_t> x = randomIntegers(shape[0], 1000), y = randomIntegers(shape[1], 1000);
+        std::vector<int64_t> expected = schoolbook(x, y);
+        std::vector<double> a(x.begin(), x.end()), b(y.begin(), y.end());
+
+        std::vector<double> product(a.size() + b.size() - 1);
+        fftMultiply(a.data(), (int)a.size(), b.data(), (int)b.size(), product.data());
+        double error = 0.0;
+        for (size_t i = 0; i < product.size(); i++)
+            error = std::max(error, std::abs(product[i] - (double)expected[i]));
+        CHECK(error < 0.01);
+
+        std::vector<int64_t> expectedSquare = schoolbook(x, x);
+        std::vector<double> square(2 * a.size() - 1);
+        fftSquare(a.data(), (int)a.size(), square.data());
+        error = 0.0;
+        for (size_t i = 0; i < square.size(); i++)
+            error = std::max(error, std::abs(square[i] - (double)expectedSquare[i]));
+        CHECK(error < 0.01);
+    }
+}
+
+/**
+ * @brief The multi-prime NTT, exact for int64_t operands and for integer-valued doubles.
+ */
+static void checkNtt()
+{
+    for (const auto &shape : SHAPES)
+    {
+        std::vector<int64_t> x = randomIntegers(shape[0], 1000000), y = randomIntegers(shape[1], 1000000);
+        std::vector<int64_t> expected = schoolbook(x, y);
+
+        std::vector<int64_t> product(expected.size());
+        CHECK(nttMultiply(x.data(), (int)x.size(), y.data(), (int)y.size(), product.data()));
+        CHECK(product == expected);
+
+        std::vector<double> a(x.begin(), x.end()), b(y.begin(), y.end()), real(expected.size());
+        CHECK(nttMultiply(a.data(), (int)a.size(), b.data(), (int)b.size(), real.data()));
+        CHECK(std::equal(real.begin(), real.end(), expected.begin(),
+                         [](double value, int64_t exact) { return value == (double)exact; }));
+    }
+
+    // Coefficients whose products could exceed the three primes are refused rather than wrapped
+    std::vector<int64_t> huge(600, INT64_C(1) << 60), product(1199);
+    CHECK(!nttMultiply(huge.data(), 600, huge.data(), 600, product.data()));
+
+    // Products up to about 6e18 still fit in an int64_t, through all three primes
+    std::vector<int64_t> x = randomIntegers(600, 100000000), y = randomIntegers(600, 100000000);
+    x[0] = y[0] = 100000000;
+    CHECK(nttMultiply(x.data(), 600, y.data(), 600, product.data()));
+    CHECK(product == schoolbook(x, y));
+}
+
+/**
+ * @brief Products whose coefficients do not fit in an int64_t, which the NTT must refuse rather than truncate.
+ *
+ * With 600 coefficients around 1e9, the product reaches about 6e20: the int64_t and double NTT
+ * refuse it, and `convolutionMultiply` in `Ntt` mode falls back to the FFT, which rounds it.
+ */
+static void checkLargeCoefficients()
+{
+    // Positive coefficients in [5e8, 1e9], so the middle of the product does not cancel
+    std::vector<int64_t> x = randomIntegers(600, 250000000), y = randomIntegers(600, 250000000);
+    for (int64_t &value : x)
+        value += 750000000;
+    for (int64_t &value : y)
+        value += 750000000;
+
+    std::vector<int64_t> product(1199);
+    CHECK(!nttMultiply(x.data(), 600, y.data(), 600, product.data()));
+
+    std::vector<double> a(x.begin(), x.end()), b(y.begin(), y.end()), real(1199);
+    CHECK(!nttMultiply(a.data(), 600, b.data(), 600, real.data()));
+
+    std::vector<long double> expected(1199, 0.0L);
+    long double largest = 0.0L;
+    for (int i = 0; i < 600; i++)
+        for (int j = 0; j < 600; j++)
+            expected[i + j] += (long double)x[i] * y[j];
+    for (long double value : expected)
+        largest = std::max(largest, std::fabs(value));
+
+    for (ConvolutionMode mode : {ConvolutionMode::Ntt, ConvolutionMode::Fft})
+    {
+        convolutionMultiply(a.data(), 600, b.data(), 600, real.data(), mode);
+        long double error = 0.0L;
+        for (int i = 0; i < 1199; i++)
+            error = std::max(error, std::fabs((long double)real[i] - expected[i]));
+        CHECK(largest > 1e20L && error < 1e-9L * largest);
+    }
+}
+
+/**
+ * @brief The single-prime NTT modulo each of `NTT_PRIMES`.
+ */
+static void checkNttModulo()
+{
+    for (uint32_t prime : NTT_PRIMES)
+    {
+        for (const auto &shape : SHAPES)
+        {
+            std::vector<uint32_t> a(shape[0]), b(shape[1]);
+            for (uint32_t &value : a)
+                value = (uint32_t)(generator() % prime);
+            for (uint32_t &value : b)
+                value = (uint32_t)(generator() % prime);
+
+            std::vector<uint32_t> expected(a.size() + b.size() - 1, 0);
+            for (size_t i = 0; i < a.size(); i++)
+                for (size_t j = 0; j < b.size(); j++)
+                    expected[i + j] = (uint32_t)((expected[i + j] + (uint64_t)a[i] * b[j]) % prime);
+
+            std::vector<uint32_t> product(expected.size());
+            CHECK(nttMultiplyModulo(a.data(), (int)a.size(), b.data(), (int)b.size(), product.data(), prime));
+            CHECK(product == expected);
+        }
+    }
+}
+
+/**
+ * @brief ModInt products through `multiplyVectors` and `squareVectors`.
+ *
+ * The last product is longer than `NTT_MAX_LENGTH`, so it goes through blocks of half a transform;
+ * the schoolbook method being out of reach there, it is checked at a random point (a wrong product
+ * agrees with the right one there with probability about deg / MODULUS) and at a few coefficients.
+ */
+static void checkModular()
+{
+    auto randomModular = [](int n)
+    {
+        std::vector<ModInt> values(n);
+        for (ModInt &value : values)
+            value = ModInt((int64_t)(generator() % ModInt::MODULUS));
+        return values;
+    };
+
+    for (const auto &shape : SHAPES)
+    {
+        std::vector<ModInt> a = randomModular(shape[0]), b = randomModular(shape[1]);
+        CHECK(multiplyVectors(a, b) == schoolbook(a, b));
+        CHECK(squareVectors(a) == schoolbook(a, a));
+    }
+
+    int n = NTT_MAX_LENGTH / 2 + 1000;
+    int m = NTT_MAX_LENGTH / 2 + 3;
+    std::vector<ModInt> a = randomModular(n), b = randomModular(m);
+    std::vector<ModInt> product = multiplyVectors(a, b);
+    CHECK((int)product.size() == n + m - 1);
+
+    auto evaluate = [](const std::vector<ModInt> &p, ModInt x)
+    {
+        ModInt value(0);
+        for (size_t i = p.size(); i-- > 0;)
+            value = value * x + p[i];
+        return value;
+    };
+    ModInt x((int64_t)(generator() % ModInt::MODULUS));
+    CHECK(evaluate(product, x) == evaluate(a, x) * evaluate(b, x));
+
+    for (int k : {0, NTT_MAX_LENGTH / 2 - 1, NTT_MAX_LENGTH / 2, NTT_MAX_LENGTH / 2 + 1500, n + m - 2})
+    {
+        ModInt coefficient(0);
+        for (int i = std::max(0, k - m + 1); i <= std::min(k, n - 1); i++)
+            coefficient += a[i] * b[k - i];
+        CHECK(product[k] == coefficient);
+    }
+}
+
+int main()
+{
+    checkFft();
+    checkNtt();
+    checkLargeCoefficients();
+    checkNttModulo();
+    checkModular();
+    return finishChecks("ConvolutionTest");
+}
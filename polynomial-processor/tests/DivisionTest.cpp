@@ -0,0 +1,260 @@
+#include "../include/Division.h"
+#include "Check.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Checks of `dividePolynomials`, `polynomialRemainder` and `polynomialGcd` against the naive long
+ * division, on random dense operands (divided through the Newton reciprocal past `newtonThreshold`)
+ * and on sparse dividends of large degree (divided term by term, or reduced with
+ * `Modulus::monomial` once the quotient fills in).
+ */
+
+static std::mt19937_64 generator(2024);
+
+/**
+ * @brief Returns a random non-zero coefficient in [-limit, limit].
+ */
+template <typename T>
+static T randomCoefficient(int limit)
+{
+    int64_t value = 0;
+    while (value == 0)
+        value = (int64_t)(generator() % (2 * limit + 1)) - limit;
+    return T(value);
+}
+
+/**
+ * @brief Returns a polynomial of the given degree with up to `terms` random terms.
+ *
+ * @param limit Largest magnitude of the coefficients.
+ * @param monic Whether the leading coefficient is 1.
+ *
+ * The constant term is never zero, so two random cofactors do not share the factor x.
+ */
+template <typename T>
+static BasicList<T> randomPolynomial(int degree, int terms, int limit, bool monic)
+{
+    std::vector<T> coefficients(degree + 1, T(0));
+    for (int i = 1; i < terms; i++)
+        coefficients[generator() % (degree + 1)] = randomCoefficient<T>(limit);
+    coefficients[0] = randomCoefficient<T>(limit);
+    coefficients[degree] = monic ? T(1) : randomCoefficient<T>(limit);
+
+    BasicList<T> p;
+    for (int d = degree; d >= 0; d--)
+        if (coefficients[d] != T(0))
+            p.append(coefficients[d], d);
+    return p;
+}
+
+/**
+ * @brief Returns the polynomial with the given terms, listed from the highest degree down.
+ */
+template <typename T>
+static BasicList<T> polynomialOf(std::initializer_list<std::pair<T, int>> terms)
+{
+    BasicList<T> p;
+    for (const auto &[coefficient, degree] : terms)
+        p.append(coefficient, degree);
+    return p;
+}
+
+/**
+ * @brief Divides two coefficient vectors with the schoolbook long division, one quotient coefficient at a time.
+ *
+ * @return `false` if a quotient coefficient is not an integer (int64_t only); otherwise, `true`.
+ */
+template <typename A>
+static bool naiveDivide(std::vector<A> a, const std::vector<A> &b, std::vector<A> &quotient, std::vector<A> &remainder)
+{
+    quotient.assign(a.size() >= b.size() ? a.size() - b.size() + 1 : 0, A(0));
+    for (size_t i = quotient.size(); i-- > 0;)
+    {
+        A numerator = a[i + b.size() - 1];
+        if constexpr (std::is_same<A, int64_t>::value)
+        {
+            if (numerator % b.back() != 0)
+                return false;
+            quotient[i] = numerator / b.back();
+        }
+        else if constexpr (std::is_same<A, ModInt>::value)
+        {
+            quotient[i] = numerator * b.back().inverse();
+        }
+        else
+        {
+            quotient[i] = numerator / b.back();
+        }
+        for (size_t j = 0; j < b.size(); j++)
+            a[i + j] -= quotient[i] * b[j];
+    }
+    a.resize(std::min(a.size(), b.size() - 1));
+    remainder = a;
+    return true;
+}
+
+/**
+ * @brief Tells whether a polynomial has the expected coefficients, up to rounding for double.
+ *
+ * Missing high coefficients count as zeros, and floating-point coefficients are compared relative
+ * to the largest expected one.
+ */
+template <typename T, typename A>
+static bool matches(const BasicList<T> &p, std::vector<A> expected)
+{
+    std::vector<A> actual = p.getCoefficients();
+    size_t length = std::max(actual.size(), expected.size());
+    actual.resize(length, A(0));
+    expected.resize(length, A(0));
+    if constexpr (std::is_floating_point<A>::value)
+    {
+        A largest = 1;
+        for (A coefficient : expected)
+            largest = std::max(largest, std::abs(coefficient));
+        for (size_t i = 0; i < length; i++)
+            if (std::abs(actual[i] - expected[i]) > 1e-6 * largest)
+                return false;
+        return true;
+    }
+    else
+    {
+        return actual == expected;
+    }
+}
+
+/**
+ * @brief Checks the quotient and the remainder of a by b against the naive long division.
+ */
+template <typename T>
+static void checkDivision(const BasicList<T> &a, const BasicList<T> &b)
+{
+    using Accumulator = typename BasicList<T>::Accumulator;
+
+    std::vector<Accumulator> q, r;
+    bool exact = naiveDivide(a.getCoefficients(), b.getCoefficients(), q, r);
+
+    BasicList<T> quotient, remainder, rest;
+    CHECK(dividePolynomials(a, b, quotient, remainder) == exact);
+    CHECK(polynomialRemainder(a, b, rest) == exact);
+    if (exact)
+    {
+        CHECK(matches(quotient, q));
+        CHECK(matches(remainder, r));
+        CHECK(matches(rest, r));
+    }
+}
+
+/**
+ * @brief Random divisions of every shape for one coefficient type.
+ *
+ * @param limit Largest magnitude of the random coefficients.
+ * @param scale Factor applied to the degrees, to keep the int64_t and double quotients from growing too large.
+ */
+template <typename T>
+static void checkRandomDivisions(int limit, double scale)
+{
+    const int shapes[][2] = {{20, 5}, {200, 3}, {200, 100}, {1000, 300}, {3000, 1000}};
+    for (const auto &shape : shapes)
+    {
+        int degreeA = std::max(1, (int)(shape[0] * scale));
+        int degreeB = std::max(1, (int)(shape[1] * scale));
+        checkDivision(randomPolynomial<T>(degreeA, degreeA + 1, limit, false),
+                      randomPolynomial<T>(degreeB, degreeB + 1, 1, true));
+    }
+
+    // Sparse dividends, whose quotient stays sparse or fills in
+    const int sparseShapes[][3] = {{5000, 8, 3}, {5000, 8, 40}, {4000, 5, 2000}, {3000, 4, 1}};
+    for (const auto &shape : sparseShapes)
+        checkDivision(randomPolynomial<T>(shape[0], shape[1], limit, false),
+                      randomPolynomial<T>(shape[2], 3, 1, true));
+}
+
+/**
+ * @brief Divisions over the integers, by divisors whose quotients stay small.
+ */
+static void checkIntegerDivisions()
+{
+    // Cyclotomic divisors have all their roots on the unit circle, so the quotients do not overflow
+    BasicList<int64_t> divisors[] = {
+        polynomialOf<int64_t>({{1, 2}, {1, 1}, {1, 0}}),
+        polynomialOf<int64_t>({{1, 4}, {-1, 2}, {1, 0}}),
+        polynomialOf<int64_t>({{1, 5}, {-1, 0}}),
+    };
+    for (const BasicList<int64_t> &b : divisors)
+    {
+        checkDivision(randomPolynomial<int64_t>(300, 301, 9, false), b);
+        checkDivision(randomPolynomial<int64_t>(6000, 6, 9, false), b);
+    }
+
+    // A non-monic divisor divides exactly only its multiples
+    BasicList<int64_t> b = polynomialOf<int64_t>({{2, 1}, {1, 0}});
+    BasicList<int64_t> q = polynomialOf<int64_t>({{1, 50}, {3, 7}, {-1, 0}});
+    checkDivision(b * q, b);
+    checkDivision(polynomialOf<int64_t>({{1, 3}, {1, 0}}), b);
+    checkDivision(polynomialOf<int64_t>({{2, 4000}, {1, 3999}, {6, 8}, {3, 7}}), b);
+}
+
+/**
+ * @brief Sparse operands of a degree no coefficient array could hold.
+ */
+static void checkHugeDegrees()
+{
+    using Poly = BasicList<ModInt>;
+    Poly a = polynomialOf<ModInt>({{1, 1000000000}, {1, 0}});
+
+    Poly remainder;
+    CHECK(polynomialRemainder(a, polynomialOf<ModInt>({{1, 2}, {1, 0}}), remainder));
+    CHECK(matches(remainder, std::vector<ModInt>{2}));
+    CHECK(polynomialRemainder(a, polynomialOf<ModInt>({{1, 1}, {1, 0}}), remainder));
+    CHECK(matches(remainder, std::vector<ModInt>{2}));
+    CHECK(polynomialRemainder(a, polynomialOf<ModInt>({{1, 3}, {-1, 0}}), remainder));
+    CHECK(matches(remainder, std::vector<ModInt>{1, 1}));
+
+    // (x^n - 1) / (x^k - 1) = x^(n-k) + x^(n-2k) + ... + 1
+    Poly quotient;
+    CHECK(dividePolynomials(polynomialOf<ModInt>({{1, 1000000000}, {-1, 0}}),
+                            polynomialOf<ModInt>({{1, 100000000}, {-1, 0}}), quotient, remainder));
+    CHECK(quotient.size() == 10 && quotient.getDegree() == 900000000 && remainder.isEmpty());
+
+    Poly gcd;
+    CHECK(polynomialGcd(polynomialOf<ModInt>({{1, 1000000000}, {-1, 0}}),
+                        polynomialOf<ModInt>({{1, 600000000}, {-1, 0}}), gcd));
+    CHECK(gcd.size() == 2 && gcd.getDegree() == 200000000);
+    CHECK(polynomialGcd(a, Poly(), gcd) && gcd.size() == 2 && gcd.getDegree() == 1000000000);
+}
+
+/**
+ * @brief GCDs of multiples of a known common factor, which random cofactors almost never extend.
+ */
+static void checkGcds()
+{
+    const int shapes[][3] = {{30, 200, 150}, {100, 600, 500}, {5, 3000, 40}};
+    for (const auto &shape : shapes)
+    {
+        BasicList<ModInt> c = randomPolynomial<ModInt>(shape[0], shape[0] + 1, 9, true);
+        BasicList<ModInt> a = c * randomPolynomial<ModInt>(shape[1], shape[1] + 1, 9, false);
+        BasicList<ModInt> b = c * randomPolynomial<ModInt>(shape[2], 4, 9, false);
+
+        BasicList<ModInt> gcd;
+        CHECK(polynomialGcd(a, b, gcd));
+        CHECK(matches(gcd, c.getCoefficients()));
+    }
+
+    BasicList<int64_t> gcd;
+    CHECK(polynomialGcd(polynomialOf<int64_t>({{2, 3000}, {-2, 0}}), polynomialOf<int64_t>({{4, 1200}, {-4, 0}}), gcd));
+    CHECK(matches(gcd, (polynomialOf<int64_t>({{2, 600}, {-2, 0}})).getCoefficients()));
+}
+
+int main()
+{
+    checkRandomDivisions<ModInt>(9, 1.0);
+    checkRandomDivisions<double>(1, 0.1);
+    checkIntegerDivisions();
+    checkHugeDegrees();
+    checkGcds();
+    return finishChecks("DivisionTest");
+}
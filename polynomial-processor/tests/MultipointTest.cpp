@@ -0,0 +1,104 @@
+#include "../include/MultipointEvaluation.h"
+#include "Check.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+/**
+ * Checks of `multipointEvaluate` against `List::evaluateMany`. The settings are lowered so that the
+ * evaluation goes down the subproduct tree: with `minPoints` at 0 and a `crossover` of 8, any dense
+ * polynomial of more than 8 terms evaluated at more than 8 points is remaindered through a tree
+ * several levels deep. A last check keeps the default settings, past their crossover, and another
+ * checks that a zero value comes out as +0.
+ */
+
+static std::mt19937_64 generator(2024);
+
+/**
+ * @brief Returns a monic polynomial of degree `terms - 1` with random coefficients in [-9, 9] below the leading one.
+ */
+template <typename T>
+static BasicList<T> randomPolynomial(int terms)
+{
+    BasicList<T> p;
+    p.append(T(1), terms - 1);
+    for (int degree = terms - 2; degree >= 0; degree--)
+    {
+        int64_t value = (int64_t)(generator() % 19) - 9;
+        if (value != 0)
+            p.append(T(value), degree);
+    }
+    return p;
+}
+
+/**
+ * @brief Evaluates random ModInt polynomials at random points through the tree and with Horner's rule.
+ */
+static void checkModular(int terms, int points)
+{
+    BasicList<ModInt> p = randomPolynomial<ModInt>(terms);
+    std::vector<ModInt> xs(points), expected(points), actual(points);
+    for (ModInt &x : xs)
+        x = ModInt((int64_t)(generator() % ModInt::MODULUS));
+
+    p.evaluateMany(xs.data(), expected.data(), points);
+    multipointEvaluate(p, xs.data(), actual.data(), points);
+    CHECK(actual == expected);
+}
+
+/**
+ * @brief Evaluates random double polynomials at small points, whose products stay within `maxProductGrowth`.
+ *
+ * With |x| <= 0.005, the bound prod(1 + |x_i|) of 2000 points is below 2^15, far from the default 2^24.
+ */
+static void checkFloating(int terms, int points)
+{
+    BasicList<double> p = randomPolynomial<double>(terms);
+    std::vector<double> xs(points), expected(points), actual(points);
+    std::uniform_real_distribution<double> distribution(-0.005, 0.005);
+    for (double &x : xs)
+        x = distribution(generator);
+
+    p.evaluateMany(xs.data(), expected.data(), points);
+    multipointEvaluate(p, xs.data(), actual.data(), points);
+    bool close = true;
+    for (int i = 0; i < points; i++)
+        close = close && std::abs(actual[i] - expected[i]) <= 1e-9 * (1.0 + std::abs(expected[i]));
+    CHECK(close);
+}
+
+/**
+ * @brief A zero value is +0, not the -0 of a negative coefficient times a power of x = 0.
+ */
+static void checkPositiveZero()
+{
+    BasicList<double> p;
+    p.append(-3.0, 2);
+    CHECK(!std::signbit(p.evaluateAt(0.0)));
+
+    std::vector<double> xs = {0.0, 1.0}, values(2);
+    p.evaluateMany(xs.data(), values.data(), 2);
+    CHECK(!std::signbit(values[0]) && values[1] == -3.0);
+    multipointEvaluate(p, xs.data(), values.data(), 2);
+    CHECK(!std::signbit(values[0]) && values[1] == -3.0);
+}
+
+int main()
+{
+    checkPositiveZero();
+
+    MultipointSettings defaults = multipointSettings();
+    multipointSettings().minPoints = 0;
+    multipointSettings().crossover = 8;
+
+    const int shapes[][2] = {{16, 16}, {100, 37}, {37, 100}, {500, 500}, {2000, 300}, {300, 2000}};
+    for (const auto &shape : shapes)
+    {
+        checkModular(shape[0], shape[1]);
+        checkFloating(shape[0], shape[1]);
+    }
+
+    multipointSettings() = defaults;
+    checkModular(defaults.minPoints + 1000, defaults.minPoints + 1000);
+    return finishChecks("MultipointTest");
+}
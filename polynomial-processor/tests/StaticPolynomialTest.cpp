@@ -0,0 +1,70 @@
+#include "../include/StaticPolynomial.h"
+#include "Check.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Checks of `StaticPolynomial`: its arithmetic and evaluation are checked by `static_assert`, so a
+ * change that keeps them from folding at compile time breaks the build of this program, and the
+ * runtime-only converters to and from `BasicList` are checked when it runs.
+ */
+
+using Linear = StaticPolynomial<1, int64_t>;
+using Quadratic = StaticPolynomial<2, int64_t>;
+
+constexpr Linear p(1, 2);        // 1 + 2x
+constexpr Quadratic q(-3, 0, 1); // -3 + x^2
+
+// Sum and difference, with the degree bound of the larger operand
+static_assert((p + q) == Quadratic(-2, 2, 1));
+static_assert((q + p) == Quadratic(-2, 2, 1));
+static_assert((q - p) == Quadratic(-4, -2, 1));
+static_assert(decltype(p + q)::DEGREE == 2);
+
+// Products, with degree bound N + M
+static_assert((p * q) == StaticPolynomial<3, int64_t>(-3, -6, 1, 2));
+static_assert((p * p) == Quadratic(1, 4, 4));
+static_assert((q * int64_t(3)) == Quadratic(-9, 0, 3));
+static_assert(decltype(p * q)::DEGREE == 3);
+
+// Evaluation with Horner's rule, which must agree with the product of the values
+static_assert(p(0) == 1 && p(5) == 11 && p.evaluate(-1) == -1);
+static_assert(q(2) == 1 && q(-3) == 6);
+static_assert((p * q)(4) == p(4) * q(4));
+static_assert(StaticPolynomial<0, int64_t>(7)(100) == 7);
+
+// Degree, derivative and the zero polynomial
+static_assert(q.getDegree() == 2 && Quadratic(5, 1).getDegree() == 1 && Quadratic().getDegree() == 0);
+static_assert(q.derivative() == Linear(0, 2));
+static_assert((p * q).derivative() == Quadratic(-6, 2, 6));
+
+// Floating-point coefficients fold as well
+constexpr StaticPolynomial<2, double> r(0.5, -1.0, 2.0);
+static_assert(r(2.0) == 6.5);
+static_assert((r * r)(2.0) == 42.25);
+
+/**
+ * @brief The converters to and from `BasicList`, the only members that do not run at compile time.
+ */
+static void checkConversions()
+{
+    BasicList<int64_t> list = (p * q).toList();
+    CHECK(list.size() == 4 && list.getDegree() == 3);
+    CHECK((list.getCoefficients() == std::vector<int64_t>{-3, -6, 1, 2}));
+
+    StaticPolynomial<3, int64_t> back;
+    CHECK((StaticPolynomial<3, int64_t>::fromList(list, back) && back == p * q));
+
+    // A list of degree above N is refused and leaves the output untouched
+    Quadratic untouched = q;
+    CHECK(!Quadratic::fromList(list, untouched) && untouched == q);
+
+    CHECK(Quadratic().toList().isEmpty());
+    CHECK(Quadratic::fromList(BasicList<int64_t>(), untouched) && untouched == Quadratic());
+}
+
+int main()
+{
+    checkConversions();
+    return finishChecks("StaticPolynomialTest");
+}